@@ -0,0 +1,117 @@
+
+#include <imogen_render/imogen_render.h>
+
+int main (int argc, char* argv[])
+{
+	using namespace Imogen;
+
+	juce::ScopedJuceInitialiser_GUI juceInit;
+
+	juce::ConsoleApplication app;
+
+	app.addHelpCommand ("--help|-h", "Usage:", true);
+
+	app.addDefaultCommand ({ "benchmark",
+							 "[--double] [--full] [--seconds <n>] [--csv <file>]",
+							 "Benchmarks Imogen's engine across blocksizes, samplerates, voice counts and effects",
+							 "By default each dimension is swept on its own around a 512-sample, 48 kHz, 4-voice case with all effects on. "
+							 "--full runs the complete blocksize x samplerate x voice count matrix instead.",
+							 [] (const juce::ArgumentList& arguments)
+							 {
+								 auto args = arguments;
+
+								 const auto useDouble = args.removeOptionIfFound ("--double");
+								 const auto fullSweep = args.removeOptionIfFound ("--full");
+
+								 auto seconds = 4.;
+
+								 if (const auto secondsArg = args.removeValueForOption ("--seconds"); secondsArg.isNotEmpty())
+									 seconds = juce::jmax (0.1, secondsArg.getDoubleValue());
+
+								 std::unique_ptr<juce::FileOutputStream> csv;
+
+								 if (const auto csvPath = args.removeValueForOption ("--csv"); csvPath.isNotEmpty())
+								 {
+									 const auto csvFile = juce::File::getCurrentWorkingDirectory().getChildFile (csvPath);
+									 csvFile.deleteFile();
+
+									 csv = std::make_unique<juce::FileOutputStream> (csvFile);
+
+									 if (! csv->openedOk())
+										 juce::ConsoleApplication::fail ("Could not open " + csvFile.getFullPathName());
+
+									 Benchmark::printHeader (*csv);
+								 }
+
+								 Benchmark benchmark { useDouble, seconds };
+
+								 const auto cases = fullSweep ? Benchmark::getFullMatrix() : Benchmark::getDefaultSweep();
+
+								 std::cout << "Engine<" << (useDouble ? "double" : "float") << ">, " << cases.size() << " cases" << std::endl;
+
+								 for (const auto& benchmarkCase : cases)
+								 {
+									 const auto result = benchmark.run (benchmarkCase);
+
+									 std::cout << benchmarkCase.getDescription() << ": "
+											   << juce::String (result.nanosPerSample, 1) << " ns/sample, "
+											   << juce::String (result.realtimeFactor, 1) << "x real time" << std::endl;
+
+									 result.printStageBreakdown (std::cout);
+
+									 if (csv != nullptr)
+										 Benchmark::printResult (*csv, result);
+								 }
+							 } });
+
+	app.addCommand ({ "--regression",
+					  "--regression <golden folder> [--record] [--double] [--tolerance <n>] [--max-slowdown <percent>]",
+					  "Compares a fixed corpus of renders against stored goldens and throughput baselines",
+					  "Each case is rendered with fixed parameters and compared sample by sample against its golden output "
+					  "(default tolerance 1e-4), and fails if it renders more than --max-slowdown percent (default 10) slower than its baseline. "
+					  "--record writes new goldens and baselines instead.",
+					  [] (const juce::ArgumentList& arguments)
+					  {
+						  auto args = arguments;
+
+						  RegressionSettings settings;
+
+						  settings.goldenFolder	   = juce::File::getCurrentWorkingDirectory().getChildFile (args.removeValueForOption ("--regression"));
+						  settings.record		   = args.removeOptionIfFound ("--record");
+						  settings.doublePrecision = args.removeOptionIfFound ("--double");
+
+						  if (const auto tolerance = args.removeValueForOption ("--tolerance"); tolerance.isNotEmpty())
+							  settings.tolerance = tolerance.getFloatValue();
+
+						  if (const auto slowdown = args.removeValueForOption ("--max-slowdown"); slowdown.isNotEmpty())
+							  settings.maxSlowdownPercent = slowdown.getDoubleValue();
+
+						  const auto results = RegressionSuite { settings }.run();
+
+						  auto failures = 0;
+
+						  for (const auto& result : results)
+						  {
+							  std::cout << result.caseName << ": " << juce::String (result.realtimeFactor, 1) << "x real time";
+
+							  if (result.baselineRealtimeFactor > 0.)
+								  std::cout << " (baseline " << juce::String (result.baselineRealtimeFactor, 1) << "x)";
+
+							  if (! settings.record)
+								  std::cout << ", max difference " << juce::String (result.maxDifference);
+
+							  std::cout << std::endl;
+
+							  if (result.failure.isNotEmpty())
+							  {
+								  std::cerr << "  FAILED: " << result.failure << std::endl;
+								  ++failures;
+							  }
+						  }
+
+						  if (failures > 0)
+							  juce::ConsoleApplication::fail (juce::String (failures) + " of " + juce::String (results.size()) + " cases failed");
+					  } });
+
+	return app.findAndRunCommand (argc, argv);
+}
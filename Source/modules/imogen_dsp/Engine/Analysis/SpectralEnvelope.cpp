@@ -0,0 +1,163 @@
+
+namespace Imogen
+{
+void SpectralEnvelope::prepare (double samplerate)
+{
+	// 30 ms frames, overlapping by half
+	const auto windowSize = juce::jmax (maxLag + 1, juce::roundToInt (samplerate * 0.03));
+
+	hopSize = windowSize / 2;
+
+	history.assign (static_cast<size_t> (windowSize), 0.f);
+	frame.assign (static_cast<size_t> (windowSize), 0.f);
+	window.resize (static_cast<size_t> (windowSize));
+
+	for (int i = 0; i < windowSize; ++i)
+		window[static_cast<size_t> (i)] = 0.5f - 0.5f * std::cos (juce::MathConstants<float>::twoPi * static_cast<float> (i) / static_cast<float> (windowSize - 1));
+
+	// a gaussian lag window widens each formant by about 80 Hz, so single harmonics don't get mistaken for formants
+	const auto bandwidth = juce::MathConstants<double>::twoPi * 80. / samplerate;
+
+	for (int lag = 0; lag <= maxLag; ++lag)
+		lagWindow[static_cast<size_t> (lag)] = static_cast<float> (std::exp (-0.5 * std::pow (bandwidth * lag, 2.)));
+
+	reset();
+}
+
+void SpectralEnvelope::reset() noexcept
+{
+	std::fill (history.begin(), history.end(), 0.f);
+
+	writePosition	  = 0;
+	samplesUntilFrame = hopSize;
+
+	autocorrelation.fill (0.f);
+	envelopeIsValid.fill (false);
+}
+
+template <typename SampleType>
+void SpectralEnvelope::analyze (const SampleType* input, int numSamples) noexcept
+{
+	const auto windowSize = static_cast<int> (history.size());
+
+	if (windowSize == 0)
+		return;
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		history[static_cast<size_t> (writePosition)] = static_cast<float> (input[i]);
+
+		if (++writePosition == windowSize)
+			writePosition = 0;
+
+		if (--samplesUntilFrame == 0)
+		{
+			analyzeFrame();
+			samplesUntilFrame = hopSize;
+		}
+	}
+}
+
+template void SpectralEnvelope::analyze (const float*, int) noexcept;
+template void SpectralEnvelope::analyze (const double*, int) noexcept;
+
+void SpectralEnvelope::analyzeFrame() noexcept
+{
+	const auto windowSize = static_cast<int> (history.size());
+
+	// the oldest sample is at the write position
+	for (int i = 0, read = writePosition; i < windowSize; ++i)
+	{
+		frame[static_cast<size_t> (i)] = history[static_cast<size_t> (read)] * window[static_cast<size_t> (i)];
+
+		if (++read == windowSize)
+			read = 0;
+	}
+
+	for (int lag = 0; lag <= maxLag; ++lag)
+	{
+		auto sum = 0.f;
+
+		for (int i = lag; i < windowSize; ++i)
+			sum += frame[static_cast<size_t> (i)] * frame[static_cast<size_t> (i - lag)];
+
+		autocorrelation[static_cast<size_t> (lag)] = sum * lagWindow[static_cast<size_t> (lag)];
+	}
+
+	// a -40 dB noise floor keeps the prediction well conditioned
+	autocorrelation[0] *= 1.0001f;
+
+	envelopeIsValid.fill (false);
+	++frameIndex;
+}
+
+/*
+	Shifting every frequency up by a ratio r squeezes the autocorrelation in time, so the shifted signal's
+	autocorrelation at lag k is the input's at lag k * r. The envelope is then found by the Levinson-Durbin recursion.
+*/
+const SpectralEnvelope::Envelope& SpectralEnvelope::getEnvelope (int semitones) noexcept
+{
+	semitones = juce::jlimit (-maxShiftSemitones, maxShiftSemitones, semitones);
+
+	const auto index = static_cast<size_t> (semitones + maxShiftSemitones);
+
+	auto& envelope = envelopes[index];
+
+	if (envelopeIsValid[index])
+		return envelope;
+
+	envelopeIsValid[index] = true;
+	envelope			   = {};
+
+	if (autocorrelation[0] <= 1.0e-9f)
+		return envelope;
+
+	const auto ratio = std::pow (2., semitones / 12.);
+
+	std::array<double, order + 1> shifted;
+
+	for (int lag = 0; lag <= order; ++lag)
+	{
+		const auto position = lag * ratio;
+		const auto whole	= static_cast<int> (position);
+		const auto fraction = position - whole;
+
+		const auto first  = static_cast<double> (autocorrelation[static_cast<size_t> (whole)]);
+		const auto second = static_cast<double> (autocorrelation[static_cast<size_t> (juce::jmin (whole + 1, maxLag))]);
+
+		shifted[static_cast<size_t> (lag)] = first + fraction * (second - first);
+	}
+
+	std::array<double, order + 1> predictor {}, previous {};
+	predictor[0] = 1.;
+
+	auto error = shifted[0];
+
+	for (int m = 1; m <= order; ++m)
+	{
+		auto sum = shifted[static_cast<size_t> (m)];
+
+		for (int i = 1; i < m; ++i)
+			sum += predictor[static_cast<size_t> (i)] * shifted[static_cast<size_t> (m - i)];
+
+		// interpolating the autocorrelation can very slightly break its positive definiteness, so the filter is kept stable here
+		const auto reflection = juce::jlimit (-0.999, 0.999, -sum / error);
+
+		previous = predictor;
+
+		for (int i = 1; i < m; ++i)
+			predictor[static_cast<size_t> (i)] = previous[static_cast<size_t> (i)] + reflection * previous[static_cast<size_t> (m - i)];
+
+		predictor[static_cast<size_t> (m)] = reflection;
+
+		error *= 1. - reflection * reflection;
+
+		envelope.reflection[static_cast<size_t> (m - 1)] = static_cast<float> (reflection);
+	}
+
+	envelope.predictionError = static_cast<float> (error / shifted[0]);
+
+	return envelope;
+}
+
+}  // namespace Imogen
@@ -0,0 +1,65 @@
+#pragma once
+
+namespace Imogen
+{
+/* Estimates the spectral envelope of the input with linear prediction, once per analysis frame, for every harmony voice to share.
+   PSOLA moves the formants along with the pitch; each voice undoes that by whitening its output with the envelope
+   shifted by its own interval and recolouring it with the input's envelope (see FormantCorrector).
+   Envelopes for each interval are only worked out when a voice first asks for them, and then cached until the next frame,
+   so the cost grows with the number of frames and distinct intervals, not with the number of voices.
+*/
+class SpectralEnvelope
+{
+public:
+
+	static constexpr int order = 16;
+
+	/* Larger intervals are corrected as if they were this many semitones. */
+	static constexpr int maxShiftSemitones = 12;
+
+	/* An all-pole envelope, as the reflection coefficients of a lattice filter. */
+	struct Envelope
+	{
+		std::array<float, order> reflection {};
+
+		/* How much of the signal's power the envelope can't predict, from 0 to 1. */
+		float predictionError { 1.f };
+	};
+
+	void prepare (double samplerate);
+
+	void reset() noexcept;
+
+	template <typename SampleType>
+	void analyze (const SampleType* input, int numSamples) noexcept;
+
+	/* The input's envelope as it would be if every frequency were shifted by this many semitones.
+	   Don't call this from more than one thread at a time.
+	*/
+	const Envelope& getEnvelope (int semitones) noexcept;
+
+	/* Counts analysis frames, so callers can tell when the envelopes have changed. */
+	juce::uint64 getFrameIndex() const noexcept { return frameIndex; }
+
+private:
+
+	void analyzeFrame() noexcept;
+
+	static constexpr int numShifts = maxShiftSemitones * 2 + 1;
+
+	// shifting up by an octave reads the autocorrelation at up to twice the order
+	static constexpr int maxLag = order * 2 + 1;
+
+	std::vector<float> history, window, frame;
+
+	int writePosition { 0 }, samplesUntilFrame { 0 }, hopSize { 0 };
+
+	std::array<float, maxLag + 1> lagWindow {}, autocorrelation {};
+
+	std::array<Envelope, numShifts> envelopes;
+	std::array<bool, numShifts>		envelopeIsValid {};
+
+	juce::uint64 frameIndex { 0 };
+};
+
+}  // namespace Imogen
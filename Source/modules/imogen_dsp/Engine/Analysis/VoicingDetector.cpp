@@ -0,0 +1,75 @@
+
+namespace Imogen
+{
+void VoicingDetector::prepare (double samplerateToUse)
+{
+	samplerate = samplerateToUse;
+
+	voicedRatio	  = getRatioForFrequency (voicedFrequency, samplerate);
+	unvoicedRatio = getRatioForFrequency (unvoicedFrequency, samplerate);
+
+	reset();
+}
+
+float VoicingDetector::getRatioForFrequency (double frequency, double samplerate) noexcept
+{
+	// above Nyquist the ratio can't get any higher
+	const auto normalised = juce::jmin (frequency / samplerate, 0.5);
+
+	const auto twiceSine = 2. * std::sin (juce::MathConstants<double>::pi * normalised);
+
+	return static_cast<float> (twiceSine * twiceSine);
+}
+
+void VoicingDetector::reset() noexcept
+{
+	confidence = 0.f;
+	voiced	   = false;
+	lastSample = 0.f;
+}
+
+template <typename SampleType>
+void VoicingDetector::process (const SampleType* input, int numSamples) noexcept
+{
+	if (numSamples <= 0)
+		return;
+
+	auto energy = 0.f, differenceEnergy = 0.f;
+	auto last	= lastSample;
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const auto sample	  = static_cast<float> (input[i]);
+		const auto difference = sample - last;
+
+		energy += sample * sample;
+		differenceEnergy += difference * difference;
+
+		last = sample;
+	}
+
+	lastSample = last;
+
+	const auto blockConfidence = [&]
+	{
+		if (energy < silence * static_cast<float> (numSamples))
+			return 0.f;
+
+		const auto ratio = differenceEnergy / energy;
+
+		return juce::jlimit (0.f, 1.f, (unvoicedRatio - ratio) / (unvoicedRatio - voicedRatio));
+	}();
+
+	// about 10 ms of smoothing, independent of the blocksize
+	const auto coeff = static_cast<float> (std::exp (-static_cast<double> (numSamples) / (0.01 * samplerate)));
+
+	confidence = blockConfidence + coeff * (confidence - blockConfidence);
+
+	if (voiced ? confidence < 0.4f : confidence > 0.6f)
+		voiced = ! voiced;
+}
+
+template void VoicingDetector::process (const float*, int) noexcept;
+template void VoicingDetector::process (const double*, int) noexcept;
+
+}  // namespace Imogen
@@ -0,0 +1,48 @@
+#pragma once
+
+namespace Imogen
+{
+/* Classifies each block of the input as voiced (sung, with a stable pitch) or unvoiced (sibilants, breaths, silence),
+   with a confidence between 0 and 1.
+   Voiced sound is dominated by low harmonics, so sample-to-sample differences are small compared to the signal itself;
+   in noisy, unvoiced sound they're comparable. The ratio of the two energies is cheap and needs no pitch estimate.
+   For a sine at f Hz the ratio is (2 sin (pi f / samplerate))^2, so the thresholds are set as the frequencies whose
+   ratio they are, and converted when the samplerate is known.
+*/
+class VoicingDetector
+{
+public:
+
+	void prepare (double samplerate);
+
+	void reset() noexcept;
+
+	template <typename SampleType>
+	void process (const SampleType* input, int numSamples) noexcept;
+
+	/* 1 is certainly voiced, 0 certainly unvoiced. */
+	float getConfidence() const noexcept { return confidence; }
+
+	/* Switches with some hysteresis, so the classification doesn't flicker around 50% confidence. */
+	bool isVoiced() const noexcept { return voiced; }
+
+private:
+
+	static float getRatioForFrequency (double frequency, double samplerate) noexcept;
+
+	// where the energy's centre of mass sits in fully voiced and fully unvoiced sound
+	static constexpr double voicedFrequency = 3900., unvoicedFrequency = 8100.;
+
+	float voicedRatio { 0.3f }, unvoicedRatio { 1.2f };
+
+	static constexpr float silence = 1.0e-6f;
+
+	double samplerate { 44100. };
+
+	float confidence { 0.f };
+	bool  voiced { false };
+
+	float lastSample { 0.f };
+};
+
+}  // namespace Imogen
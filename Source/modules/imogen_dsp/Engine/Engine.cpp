@@ -9,29 +9,250 @@ Engine<SampleType>::Engine (State& stateToUse)
 template <typename SampleType>
 void Engine<SampleType>::renderChunk (const AudioBuffer& input, AudioBuffer& output, MidiBuffer& midiMessages, bool)
 {
-	output.clear();
-	updateStereoWidth (parameters.stereoWidth->get());
+	IMOGEN_REALTIME_SCOPE;
 
-	const bool leadIsBypassed		= parameters.leadBypass->get();
-	const bool harmoniesAreBypassed = parameters.harmonyBypass->get();
+	state.flightRecorder.recordBlock (input, midiMessages);
 
-	const auto numSamples = input.getNumSamples();
+	updateQualityGovernor (input.getNumSamples());
+
+	const CpuLoadMeter::ScopedMeasurement cpuMeasurement { cpuLoad, input.getNumSamples() };
+
+	startBlockDeadline (input.getNumSamples());
+
+	IMOGEN_TIME_STAGE (state, wholeChunk);
+
+	if (rateConverter.getFactor() > 1)
+		renderAtInternalRate (input, output, midiMessages);
+	else
+		renderStages (input, output, midiMessages);
+
+	updateMidiOutput (midiMessages);
+}
+
+template <typename SampleType>
+void Engine<SampleType>::renderAtInternalRate (const AudioBuffer& input, AudioBuffer& output, MidiBuffer& midiMessages)
+{
+	const auto factor			  = rateConverter.getFactor();
+	const auto numInternalSamples = rateConverter.downsample (input, internalInput);
+
+	if (numInternalSamples == 0)
+	{
+		// a host block too short to produce an internal sample still has its MIDI rendered, at the start of the next internal block
+		for (const auto metadata : midiMessages)
+			carriedMidi.addEvent (metadata.data, metadata.numBytes, 0);
+
+		midiMessages.clear();
+	}
+	else
+	{
+		internalInputAlias.setDataToReferTo (internalInput.getArrayOfWritePointers(), internalInput.getNumChannels(), numInternalSamples);
+		internalOutputAlias.setDataToReferTo (internalOutput.getArrayOfWritePointers(), internalOutput.getNumChannels(), numInternalSamples);
+
+		internalMidi.clear();
+		internalMidi.addEvents (carriedMidi, 0, -1, 0);
+		carriedMidi.clear();
+
+		for (const auto metadata : midiMessages)
+			internalMidi.addEvent (metadata.data, metadata.numBytes, juce::jmin (metadata.samplePosition / factor, numInternalSamples - 1));
+
+		renderStages (internalInputAlias, internalOutputAlias, internalMidi);
+
+		midiMessages.clear();
+
+		for (const auto metadata : internalMidi)
+			midiMessages.addEvent (metadata.data, metadata.numBytes, metadata.samplePosition * factor);
+	}
+
+	rateConverter.upsample (internalOutput, numInternalSamples, output);
+}
+
+template <typename SampleType>
+void Engine<SampleType>::renderStages (const AudioBuffer& input, AudioBuffer& output, MidiBuffer& midiMessages)
+{
+	// the pipelined mode always waits for its second half, so the worker never still owns the synthesis stage here
+	jassert (! pipelineWorker.isBusy());
+
+	updateStereoWidth (parameters.stereoWidth->get());
+
+	leadIsBypassed		 = parameters.leadBypass->get();
+	harmoniesAreBypassed = parameters.harmonyBypass->get();
 
 	if (leadIsBypassed && harmoniesAreBypassed)
 	{
-		harmonizer.bypassedBlock (numSamples, midiMessages);
+		output.clear();
+		harmonizer.bypassedBlock (input.getNumSamples(), midiMessages);
 		return;
 	}
 
-	preHarmonyEffects.process (input);
+	if (pipelined)
+	{
+		renderPipelined (input, output, midiMessages);
+		return;
+	}
+
+	/*
+		Buffer liveness through the stages:
+		- the pre-harmony mono buffer is live until the lead has been rendered;
+		- the pitch corrector's buffer is overwritten in place by the dry/corrected blend;
+		- the harmony and panned lead buffers are live until the dry/wet mixer, which writes straight into the host's output;
+		- after the mix, the harmony buffer is reused as the reverb's crossfade scratch space.
+	*/
+	renderSynthesisStage (input, midiMessages);
+	publishSynthesisState();
+
+	renderEffectsStage (harmonizer.getHarmonySignal(), leadProcessor.getProcessedSignal(), output);
+}
+
+/*
+	In pipelined mode the engine reports twice the analysis latency, and each chunk is rendered as two halves.
+	The analysis & synthesis of the second half runs on the worker thread while the audio thread
+	runs the effects on the first half, so the two heavy stages overlap instead of running back to back.
+*/
+template <typename SampleType>
+void Engine<SampleType>::renderPipelined (const AudioBuffer& input, AudioBuffer& output, MidiBuffer& midiMessages)
+{
+	const auto numSamples = input.getNumSamples();
+	const auto firstHalf  = numSamples / 2;
+	const auto secondHalf = numSamples - firstHalf;
+
+	firstHalfMidi.clear();
+	secondHalfMidi.clear();
+	firstHalfMidi.addEvents (midiMessages, 0, firstHalf, 0);
+	secondHalfMidi.addEvents (midiMessages, firstHalf, secondHalf, -firstHalf);
+
+	auto** inputChannels = const_cast<SampleType**> (input.getArrayOfReadPointers());
+
+	firstHalfInput.setDataToReferTo (inputChannels, input.getNumChannels(), 0, firstHalf);
+
+	// the worker reads its own copy of the second half, never the host's buffer
+	secondHalfInput.setDataToReferTo (secondHalfInputBuffer.getArrayOfWritePointers(), input.getNumChannels(), secondHalf);
+
+	for (int chan = 0; chan < input.getNumChannels(); ++chan)
+		secondHalfInput.copyFrom (chan, 0, input, chan, firstHalf, secondHalf);
+
+	firstHalfOutput.setDataToReferTo (output.getArrayOfWritePointers(), output.getNumChannels(), 0, firstHalf);
+	secondHalfOutput.setDataToReferTo (output.getArrayOfWritePointers(), output.getNumChannels(), firstHalf, secondHalf);
+
+	renderSynthesisStage (firstHalfInput, firstHalfMidi);
+
+	stagedHarmony.makeCopyOf (harmonizer.getHarmonySignal(), true);
+	stagedLead.makeCopyOf (leadProcessor.getProcessedSignal(), true);
+
+	pipelineWorker.launchJob();
+
+	renderEffectsStage (stagedHarmony, stagedLead, firstHalfOutput);
+
+	// the reported latency already covers the second half, so it's waited out rather than dropped,
+	// which keeps its audio and its MIDI together
+	pipelineWorker.waitForJob (AudioWorker::Deadline::max());
+
+	publishSynthesisState();
+	renderEffectsStage (harmonizer.getHarmonySignal(), leadProcessor.getProcessedSignal(), secondHalfOutput);
+
+	midiMessages.clear();
+	midiMessages.addEvents (firstHalfMidi, 0, -1, 0);
+	midiMessages.addEvents (secondHalfMidi, 0, -1, firstHalf);
+}
+
+template <typename SampleType>
+void Engine<SampleType>::renderSynthesisStage (const AudioBuffer& input, MidiBuffer& midiMessages)
+{
+	const auto numSamples = input.getNumSamples();
+
+	harmonizer.setVoiceLimit (voiceLimit.load());
+	leadProcessor.setPitchCorrectionAllowed (pitchCorrectionAllowed.load());
+
+	{
+		IMOGEN_TIME_STAGE (state, preHarmonyEffects);
+		preHarmonyEffects.process (input);
+	}
+
+	{
+		IMOGEN_TIME_STAGE (state, analysis);
+		analyzer.analyzeInput (preHarmonyEffects.getProcessedInputSignal(), numSamples);
+		updateVoicing (numSamples);
+		updateInputPitch();
+
+		if (! harmoniesAreBypassed && parameters.formantPreservation->get() > 0)
+			spectralEnvelope.analyze (preHarmonyEffects.getProcessedInputSignal(), numSamples);
+	}
+
+	{
+		IMOGEN_TIME_STAGE (state, harmonizer);
+		harmonizer.process (numSamples, midiMessages, harmoniesAreBypassed);
+	}
+
+	{
+		IMOGEN_TIME_STAGE (state, lead);
+		leadProcessor.process (leadIsBypassed, preHarmonyEffects.getProcessedInputSignal(), numSamples);
+	}
+}
+
+/*
+	During unvoiced input the harmony voices fade out and the lead fades to the uncorrected input,
+	so neither spends time shifting sibilants and breaths, which PSOLA can only smear anyway.
+*/
+template <typename SampleType>
+void Engine<SampleType>::updateVoicing (int numSamples)
+{
+	voicing.process (preHarmonyEffects.getProcessedInputSignal(), numSamples);
+
+	const auto voiced = voicing.isVoiced() || ! internals.unvoicedFastPath->get();
+
+	harmonizer.setInputVoiced (voiced);
+	leadProcessor.setInputVoiced (voiced);
+}
+
+/*
+	The pitch is tracked here, rather than by the lead's pitch corrector, because the corrector is skipped
+	whenever correction is faded out; the auto harmony, formant preservation and MIDI output all need it every block.
+*/
+template <typename SampleType>
+void Engine<SampleType>::updateInputPitch()
+{
+	const auto frequency = static_cast<float> (analyzer.getFrequency());
+
+	if (frequency > 0.f && voicing.isVoiced())
+		inputPitch = 69.f + 12.f * std::log2 (frequency / 440.f);
+	else
+		inputPitch = -1.f;
+
+	harmonizer.setInputPitch (inputPitch);
+}
+
+/*
+	The synthesis stage may run on the pipeline worker, so it only stores its meters and internals;
+	they're published from the audio thread once it's finished.
+*/
+template <typename SampleType>
+void Engine<SampleType>::publishSynthesisState()
+{
+	preHarmonyEffects.updateMeters();
+	harmonizer.publishInternals();
 
-	analyzer.analyzeInput (preHarmonyEffects.getProcessedInputSignal(), numSamples);
+	const auto inputNote = inputPitch < 0.f ? -1 : juce::roundToInt (inputPitch);
 
-	harmonizer.process (numSamples, midiMessages, harmoniesAreBypassed);
+	internals.currentInputNote->set (inputNote);
+	internals.currentCentsSharp->set (inputNote < 0 ? 0 : juce::roundToInt ((inputPitch - static_cast<float> (inputNote)) * 100.f));
 
-	leadProcessor.process (leadIsBypassed, numSamples);
+	state.meters.inputVoicing->set (juce::roundToInt (voicing.getConfidence() * 100.f));
+}
+
+template <typename SampleType>
+void Engine<SampleType>::renderEffectsStage (AudioBuffer& harmonySignal, AudioBuffer& leadSignal, AudioBuffer& output)
+{
+	IMOGEN_TIME_STAGE (state, postHarmonyEffects);
+
+	// the dry/wet mixer writes every output sample, so the output is never cleared or copied into
+	postHarmonyEffects.process (harmonySignal, leadSignal, output, blockDeadline);
+}
 
-	postHarmonyEffects.process (harmonizer.getHarmonySignal(), leadProcessor.getProcessedSignal(), output);
+template <typename SampleType>
+void Engine<SampleType>::startBlockDeadline (int numSamples) noexcept
+{
+	const auto budget = std::chrono::duration<double> (waitBudget * static_cast<double> (numSamples) / hostSamplerate);
+
+	blockDeadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration> (budget);
 }
 
 template <typename SampleType>
@@ -41,24 +262,167 @@ void Engine<SampleType>::updateStereoWidth (int width)
 	postHarmonyEffects.updateStereoWidth (width);
 }
 
+/*
+	The governor only reacts to the load of blocks that have already finished, so the
+	tier chosen here applies to this whole chunk. The offline profile always runs at full quality.
+*/
+template <typename SampleType>
+void Engine<SampleType>::updateQualityGovernor (int numSamples)
+{
+	if (internals.qualityGovernor->get() && quality != Quality::high && ! state.isUsingOfflineProfile())
+		governor.update (cpuLoad.getLastLoad(), numSamples);
+	else
+		governor.reset();
+
+	governor.setLowestAllowedTier (static_cast<QualityGovernor::Tier> (internals.forcedQualityTier->get()));
+
+	voiceLimit.store (governor.getVoiceLimit());
+	pitchCorrectionAllowed.store (governor.allowsPitchCorrection());
+
+	// the reverb only ever runs on the audio thread
+	postHarmonyEffects.setReverbAllowed (governor.allowsReverb());
+
+	state.meters.qualityTier->set (static_cast<int> (governor.getTier()));
+}
+
+template <typename SampleType>
+void Engine<SampleType>::updateMidiOutput (MidiBuffer& midiMessages)
+{
+	if (internals.midiOutput->get())
+	{
+		harmonizer.getHeldNotes (heldHarmonyNotes);
+		midiOutput.process (heldHarmonyNotes, internals.currentInputNote->get(), internals.currentCentsSharp->get(), midiMessages);
+	}
+	else if (midiOutput.hasNotesHeld())
+	{
+		midiOutput.releaseAll (midiMessages);
+	}
+}
+
 template <typename SampleType>
 void Engine<SampleType>::onPrepare (int blocksize, double samplerate)
 {
+	state.preparedSettings.store (state.getPrepareSettings());
+
+	quality = getActiveQuality();
+
+	hostSamplerate = samplerate;
+
+	const auto factor = shouldUseInternalRate() ? InternalRateConverter<SampleType>::chooseFactor (samplerate, internalSamplerate) : 1;
+
+	rateConverter.setFactor (factor);
+
+	cpuLoad.prepare (samplerate, blocksize);
+	governor.prepare (samplerate);
+	midiOutput.prepare();
+
+	const auto internalRate		 = samplerate / factor;
+	const auto internalBlocksize = blocksize / factor + 1;
+
 	if (! harmonizer.isInitialized())
-		harmonizer.initialize (16, samplerate, blocksize);
+		harmonizer.initialize (Harmonizer<SampleType>::numVoices, internalRate, internalBlocksize);
+
+	analyzer.setMinInputFreq (getMinInputFreq (parameters.analysisProfile->get()));
+	analyzer.prepare (internalRate, internalBlocksize);
+
+	pipelined = internals.pipelinedAnalysis->get();
 
-	analyzer.prepare (samplerate, blocksize);
+	auto latency = analyzer.getLatencySamples() * (pipelined ? 2 : 1);
 
-	if (const auto latency = analyzer.getLatencySamples() > 0)
+	if (factor > 1)
+		latency = latency * factor + rateConverter.getLatencySamples();
+
+	// changeLatency() may prepare the engine again, so only the outermost call reports the new latency
+	if (latency > 0 && ! changingLatency)
 	{
+		const juce::ScopedValueSetter<bool> svs (changingLatency, true);
 		dsp::LatencyEngine<SampleType>::changeLatency (latency);
+	}
+
+	const auto maxHostBlocksize = juce::jmax (blocksize, latency);
+
+	if (internals.flightRecorderEnabled->get())
+		state.flightRecorder.prepare (samplerate, maxHostBlocksize, 2);
+	else
+		state.flightRecorder.release();
+
+	if (factor == 1)
+	{
+		prepareStages (samplerate, maxHostBlocksize);
 		return;
 	}
 
+	rateConverter.prepare (2, maxHostBlocksize);
+
+	const auto maxInternalBlocksize = rateConverter.getMaxInternalBlocksize();
+
+	internalInput.setSize (2, maxInternalBlocksize);
+	internalOutput.setSize (2, maxInternalBlocksize);
+	internalMidi.ensureSize (2048);
+	carriedMidi.ensureSize (2048);
+	carriedMidi.clear();
+
+	prepareStages (internalRate, maxInternalBlocksize);
+}
+
+template <typename SampleType>
+void Engine<SampleType>::prepareStages (double samplerate, int blocksize)
+{
 	harmonizer.prepare (samplerate, blocksize);
 	leadProcessor.prepare (samplerate, blocksize);
 	preHarmonyEffects.prepare (samplerate, blocksize);
 	postHarmonyEffects.prepare (samplerate, blocksize);
+
+	voicing.prepare (samplerate);
+	spectralEnvelope.prepare (samplerate);
+
+	stagedHarmony.setSize (2, blocksize, false, false, true);
+	stagedLead.setSize (2, blocksize, false, false, true);
+	secondHalfInputBuffer.setSize (2, blocksize, false, false, true);
+
+	firstHalfMidi.ensureSize (2048);
+	secondHalfMidi.ensureSize (2048);
+
+	if (pipelined)
+		pipelineWorker.start();
+	else
+		pipelineWorker.stop();
+}
+
+template <typename SampleType>
+int Engine<SampleType>::getMinInputFreq (int analysisProfile)
+{
+	// the lowest pitch each voice type is expected to sing, with some headroom below it
+	switch (analysisProfile)
+	{
+		case (1) : return 200;	// soprano
+		case (2) : return 140;	// alto
+		case (3) : return 100;	// tenor
+		default : return 60;	// bass
+	}
+}
+
+/*
+	The profile is chosen each time the engine is prepared; the processor prepares it again when the profile in use changes,
+	as it does for all the settings in State::getPrepareSettings().
+*/
+template <typename SampleType>
+typename Engine<SampleType>::Quality Engine<SampleType>::getActiveQuality() const
+{
+	const auto& profile = state.isUsingOfflineProfile() ? internals.offlineQuality : internals.realtimeQuality;
+
+	return static_cast<Quality> (profile->get());
+}
+
+template <typename SampleType>
+bool Engine<SampleType>::shouldUseInternalRate() const
+{
+	switch (quality)
+	{
+		case (Quality::draft) : return true;
+		case (Quality::high) : return false;
+		default : return internals.fixedInternalRate->get();
+	}
 }
 
 
@@ -5,6 +5,11 @@
 #include "Lead/LeadProcessor.h"
 #include "effects/PostHarmonyEffects.h"
 #include "effects/PreHarmonyEffects.h"
+#include "Resampling/InternalRateConverter.h"
+#include "Profiling/CpuLoadMeter.h"
+#include "Governor/QualityGovernor.h"
+#include "Midi/MidiOutputGenerator.h"
+#include "Analysis/VoicingDetector.h"
 
 namespace Imogen
 {
@@ -21,22 +26,108 @@ private:
 
 	void renderChunk (const AudioBuffer& input, AudioBuffer& output, MidiBuffer& midiMessages, bool isBypassed) final;
 
+	void renderAtInternalRate (const AudioBuffer& input, AudioBuffer& output, MidiBuffer& midiMessages);
+
+	void renderStages (const AudioBuffer& input, AudioBuffer& output, MidiBuffer& midiMessages);
+
+	void renderPipelined (const AudioBuffer& input, AudioBuffer& output, MidiBuffer& midiMessages);
+
+	void renderSynthesisStage (const AudioBuffer& input, MidiBuffer& midiMessages);
+	void updateVoicing (int numSamples);
+	void updateInputPitch();
+	void publishSynthesisState();
+
+	void renderEffectsStage (AudioBuffer& harmonySignal, AudioBuffer& leadSignal, AudioBuffer& output);
+
+	void startBlockDeadline (int numSamples) noexcept;
+
 	void onPrepare (int blocksize, double samplerate) final;
 
+	void prepareStages (double samplerate, int blocksize);
+
+	static int getMinInputFreq (int analysisProfile);
+
+	enum class Quality
+	{
+		draft,
+		standard,
+		high
+	};
+
+	Quality getActiveQuality() const;
+
+	bool shouldUseInternalRate() const;
+
+	static constexpr double internalSamplerate = 44100.;
+
 	void updateStereoWidth (int width);
 
+	void updateQualityGovernor (int numSamples);
+
+	void updateMidiOutput (MidiBuffer& midiMessages);
+
 	State&		state;
 	Parameters& parameters { state.parameters };
+	Internals&	internals { state.internals };
 
 	dsp::psola::Analyzer<SampleType> analyzer;
 
+	VoicingDetector voicing;
+
+	SpectralEnvelope spectralEnvelope;
+
 	PreHarmonyEffects<SampleType> preHarmonyEffects { state };
 
-	Harmonizer<SampleType> harmonizer { state, analyzer };
+	Harmonizer<SampleType> harmonizer { state, analyzer, spectralEnvelope };
 
 	LeadProcessor<SampleType> leadProcessor { harmonizer, state };
 
 	PostHarmonyEffects<SampleType> postHarmonyEffects { state };
+
+	CpuLoadMeter cpuLoad { state.meters, state.flightRecorder };
+
+	QualityGovernor governor;
+
+	// the governor's choices for this chunk, applied by the synthesis stage, which may run on the pipeline worker
+	std::atomic<int>  voiceLimit { std::numeric_limits<int>::max() };
+	std::atomic<bool> pitchCorrectionAllowed { true };
+
+	// the input's pitch in the last synthesized block, as a fractional MIDI note, or -1 if it has none
+	float inputPitch { -1.f };
+
+	MidiOutputGenerator			 midiOutput;
+	MidiOutputGenerator::NoteSet heldHarmonyNotes;
+
+	bool leadIsBypassed { false }, harmoniesAreBypassed { false };
+
+	bool pipelined { false };
+
+	Quality quality { Quality::standard };
+
+	bool changingLatency { false };
+
+	// the share of each host block's real-time duration the audio thread may spend before it stops waiting for a worker,
+	// leaving the rest for the stages after the wait and for the host
+	static constexpr double waitBudget = 0.7;
+
+	double				  hostSamplerate { 44100. };
+	AudioWorker::Deadline blockDeadline;
+
+	AudioBuffer stagedHarmony, stagedLead;
+	AudioBuffer firstHalfInput, secondHalfInput, secondHalfInputBuffer, firstHalfOutput, secondHalfOutput;
+	MidiBuffer	firstHalfMidi, secondHalfMidi;
+
+	InternalRateConverter<SampleType> rateConverter;
+
+	AudioBuffer internalInput, internalOutput, internalInputAlias, internalOutputAlias;
+	MidiBuffer	internalMidi, carriedMidi;
+
+	AudioWorker pipelineWorker { "Imogen analysis pipeline", [this]
+								 {
+									 const ScopedTraceEvent traceEvent { state.trace, TraceRecorder::Category::worker,
+																		 static_cast<int> (TraceRecorder::Worker::analysisPipeline) };
+									 renderSynthesisStage (secondHalfInput, secondHalfMidi);
+								 } };
 };
 
 }  // namespace Imogen
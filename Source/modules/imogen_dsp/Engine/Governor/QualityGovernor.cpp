@@ -0,0 +1,79 @@
+
+namespace Imogen
+{
+void QualityGovernor::prepare (double samplerateToUse)
+{
+	samplerate = samplerateToUse;
+
+	stepDownHoldSamples = juce::roundToInt (samplerate * 0.25);
+	stepUpHoldSamples	= juce::roundToInt (samplerate * 2.);
+
+	reset();
+}
+
+void QualityGovernor::reset() noexcept
+{
+	tier				 = Tier::full;
+	smoothedLoad		 = 0.;
+	samplesSinceStepDown = stepDownHoldSamples;
+	samplesOfHeadroom	 = 0;
+}
+
+void QualityGovernor::update (double load, int numSamples) noexcept
+{
+	// about 100 ms of smoothing, independent of the blocksize
+	const auto coeff = std::exp (-static_cast<double> (numSamples) / (0.1 * samplerate));
+
+	smoothedLoad = load + coeff * (smoothedLoad - load);
+
+	samplesSinceStepDown += numSamples;
+
+	// an overrun or a sustained high load steps down, but only once the last step has had time to take effect,
+	// so a burst of overruns costs one tier rather than all of them
+	if ((load > 1. || smoothedLoad > highLoad) && samplesSinceStepDown >= stepDownHoldSamples)
+	{
+		stepDown();
+		return;
+	}
+
+	if (smoothedLoad > lowLoad)
+	{
+		samplesOfHeadroom = 0;
+		return;
+	}
+
+	samplesOfHeadroom += numSamples;
+
+	if (samplesOfHeadroom >= stepUpHoldSamples)
+		stepUp();
+}
+
+void QualityGovernor::stepDown() noexcept
+{
+	samplesSinceStepDown = 0;
+	samplesOfHeadroom	 = 0;
+
+	if (tier != Tier::noPitchCorrection)
+		tier = static_cast<Tier> (static_cast<int> (tier) + 1);
+}
+
+void QualityGovernor::stepUp() noexcept
+{
+	samplesOfHeadroom = 0;
+
+	if (tier != Tier::full)
+		tier = static_cast<Tier> (static_cast<int> (tier) - 1);
+}
+
+int QualityGovernor::getVoiceLimit() const noexcept
+{
+	switch (getTier())
+	{
+		case (Tier::full) : return std::numeric_limits<int>::max();
+		case (Tier::fewerVoices) :
+		case (Tier::noReverb) : return 8;
+		default : return 4;
+	}
+}
+
+}  // namespace Imogen
@@ -0,0 +1,57 @@
+#pragma once
+
+namespace Imogen
+{
+/* Watches each block's CPU load, and steps the engine down through cheaper quality tiers when it gets close to its deadline,
+   then back up once there's headroom again. Each tier includes all the savings of the tiers before it.
+*/
+class QualityGovernor
+{
+public:
+
+	enum class Tier
+	{
+		full,				// everything on
+		fewerVoices,		// at most 8 harmony voices; the oldest are muted beyond that, until the limit rises again
+		noReverb,			// the reverb is faded out and bypassed
+		noPitchCorrection,	// the lead's pitch correction is faded out and skipped, and at most 4 harmony voices
+		numTiers
+	};
+
+	void prepare (double samplerate);
+
+	/* Call once per block, with the load of the previous block. */
+	void update (double load, int numSamples) noexcept;
+
+	void reset() noexcept;
+
+	/* The governor never runs above this tier, however much headroom there is. */
+	void setLowestAllowedTier (Tier newLowest) noexcept { lowestAllowed = newLowest; }
+
+	Tier getTier() const noexcept { return std::max (tier, lowestAllowed); }
+
+	/* The largest number of harmony voices the current tier allows. */
+	int getVoiceLimit() const noexcept;
+
+	bool allowsReverb() const noexcept { return getTier() < Tier::noReverb; }
+	bool allowsPitchCorrection() const noexcept { return getTier() < Tier::noPitchCorrection; }
+
+private:
+
+	void stepDown() noexcept;
+	void stepUp() noexcept;
+
+	static constexpr double highLoad = 0.85, lowLoad = 0.5;
+
+	double samplerate { 44100. };
+
+	double smoothedLoad { 0. };
+
+	// steps down, even for overruns, are spaced at least 250 ms apart, and steps up need 2 s of headroom
+	int samplesSinceStepDown { 0 }, samplesOfHeadroom { 0 };
+	int stepDownHoldSamples { 0 }, stepUpHoldSamples { 0 };
+
+	Tier tier { Tier::full }, lowestAllowed { Tier::full };
+};
+
+}  // namespace Imogen
@@ -0,0 +1,50 @@
+
+namespace Imogen
+{
+namespace
+{
+/* In scale steps from the lead; 0 marks an unused slot. In the same order as the auto harmony voicing parameter. */
+static constexpr std::array<AutoHarmony::Chord, 6> voicings { {
+	{ 2, 0, 0 },	// 3rd above
+	{ 2, 4, 0 },	// 3rd & 5th above
+	{ -5, 0, 0 },	// 6th below
+	{ 2, -5, 0 },	// 3rd above & 6th below
+	{ -2, -4, 0 },	// triad below
+	{ -2, -4, -7 }	// four-part below
+} };
+}  // namespace
+
+AutoHarmony::Chord AutoHarmony::getChord (int leadNote, int key, int scale, int voicing) noexcept
+{
+	if (! juce::isPositiveAndBelow (leadNote, 128))
+		return noChord;
+
+	const auto pitchClass = ((leadNote - key) % 12 + 12) % 12;
+
+	const auto& offsets = ScaleTables::harmonyOffsets[static_cast<size_t> (juce::jlimit (0, ScaleTables::numScales - 1, scale))]
+													 [static_cast<size_t> (pitchClass)];
+
+	const auto& steps = voicings[static_cast<size_t> (juce::jlimit (0, static_cast<int> (voicings.size()) - 1, voicing))];
+
+	auto chord = noChord;
+
+	for (size_t i = 0; i < steps.size(); ++i)
+	{
+		if (steps[i] == 0)
+			continue;
+
+		const auto note = leadNote + offsets[static_cast<size_t> (steps[i] + ScaleTables::maxSteps)];
+
+		if (juce::isPositiveAndBelow (note, 128))
+			chord[i] = note;
+	}
+
+	return chord;
+}
+
+bool AutoHarmony::contains (const Chord& chord, int note) noexcept
+{
+	return std::find (chord.begin(), chord.end(), note) != chord.end();
+}
+
+}  // namespace Imogen
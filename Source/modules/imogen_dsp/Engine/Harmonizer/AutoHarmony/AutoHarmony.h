@@ -0,0 +1,25 @@
+#pragma once
+
+#include "ScaleTables.h"
+
+namespace Imogen
+{
+/* Picks diatonic harmony notes for the lead's pitch, from the tables in ScaleTables.h.
+   Each voicing is a list of scale steps away from the lead, so working out a chord is a handful of table lookups.
+*/
+struct AutoHarmony
+{
+	static constexpr int maxNotes = 3;
+
+	/* Unused slots are -1. */
+	using Chord = std::array<int, maxNotes>;
+
+	static constexpr Chord noChord { -1, -1, -1 };
+
+	/* Key is a pitch class (0 = C); scale and voicing are in the same order as their parameters. */
+	static Chord getChord (int leadNote, int key, int scale, int voicing) noexcept;
+
+	static bool contains (const Chord& chord, int note) noexcept;
+};
+
+}  // namespace Imogen
@@ -0,0 +1,66 @@
+#pragma once
+
+namespace Imogen::ScaleTables
+{
+/* In the same order as the auto harmony scale parameter. */
+static constexpr int numScales = 6, notesPerScale = 7;
+
+static constexpr std::array<std::array<int, notesPerScale>, numScales> scaleSteps { {
+	{ 0, 2, 4, 5, 7, 9, 11 },  // major
+	{ 0, 2, 3, 5, 7, 8, 10 },  // natural minor
+	{ 0, 2, 3, 5, 7, 8, 11 },  // harmonic minor
+	{ 0, 2, 3, 5, 7, 9, 11 },  // melodic minor
+	{ 0, 2, 3, 5, 7, 9, 10 },  // dorian
+	{ 0, 2, 4, 5, 7, 9, 10 }   // mixolydian
+} };
+
+/* Harmonies can be up to an octave of scale steps above or below the lead. */
+static constexpr int maxSteps = notesPerScale, numStepValues = maxSteps * 2 + 1;
+
+using OffsetTable = std::array<std::array<std::array<int, numStepValues>, 12>, numScales>;
+
+/* For every scale, every pitch class of the lead (relative to the key) and every number of scale steps,
+   the distance in semitones from the lead to the harmony note. Leads outside the scale are harmonized as
+   though they were on the scale degree below them.
+*/
+constexpr OffsetTable makeHarmonyOffsets()
+{
+	OffsetTable table {};
+
+	for (int scale = 0; scale < numScales; ++scale)
+	{
+		const auto& steps = scaleSteps[static_cast<size_t> (scale)];
+
+		for (int pitchClass = 0; pitchClass < 12; ++pitchClass)
+		{
+			auto degree = 0;
+
+			while (degree + 1 < notesPerScale && steps[static_cast<size_t> (degree + 1)] <= pitchClass)
+				++degree;
+
+			const auto chromaticOffset = pitchClass - steps[static_cast<size_t> (degree)];
+
+			for (int numSteps = -maxSteps; numSteps <= maxSteps; ++numSteps)
+			{
+				const auto target	  = degree + numSteps;
+				const auto octaves	  = (target >= 0 ? target : target - (notesPerScale - 1)) / notesPerScale;
+				const auto wrapped	  = target - octaves * notesPerScale;
+				const auto targetStep = steps[static_cast<size_t> (wrapped)] + octaves * 12;
+
+				table[static_cast<size_t> (scale)][static_cast<size_t> (pitchClass)][static_cast<size_t> (numSteps + maxSteps)]
+					= targetStep - steps[static_cast<size_t> (degree)] - chromaticOffset;
+			}
+		}
+	}
+
+	return table;
+}
+
+static constexpr auto harmonyOffsets = makeHarmonyOffsets();
+
+static_assert (harmonyOffsets[0][0][maxSteps + 2] == 4, "a 3rd above C in C major is a major 3rd");
+static_assert (harmonyOffsets[0][2][maxSteps + 2] == 3, "a 3rd above D in C major is a minor 3rd");
+static_assert (harmonyOffsets[1][0][maxSteps - 5] == -9, "a 6th below C in C minor is a major 6th");
+static_assert (harmonyOffsets[0][1][maxSteps + 2] == 3, "C# in C major is harmonized like C");
+
+}  // namespace Imogen::ScaleTables
@@ -0,0 +1,83 @@
+
+namespace Imogen
+{
+void BlockEnvelope::noteStarted() noexcept
+{
+	stage = Stage::attack;
+	level = 0.f;
+}
+
+void BlockEnvelope::noteReleased() noexcept
+{
+	stage = Stage::released;
+}
+
+template <typename SampleType>
+void BlockEnvelope::apply (SampleType* samples, int numSamples, const Settings& settings, double samplerate) noexcept
+{
+	const auto sustain = juce::jlimit (0.f, 1.f, settings.sustainLevel);
+
+	if (stage == Stage::released)
+	{
+		juce::FloatVectorOperations::multiply (samples, static_cast<SampleType> (level), numSamples);
+		return;
+	}
+
+	while (numSamples > 0)
+	{
+		if (stage == Stage::sustain)
+		{
+			level = sustain;
+			juce::FloatVectorOperations::multiply (samples, static_cast<SampleType> (level), numSamples);
+			return;
+		}
+
+		const auto isAttack = stage == Stage::attack;
+		const auto target	= isAttack ? 1.f : sustain;
+		const auto seconds	= isAttack ? settings.attackSeconds : settings.decaySeconds;
+		const auto distance = target - level;
+
+		const auto segmentSamples = static_cast<float> (seconds * samplerate);
+
+		// the segment has already been passed, e.g. because the sustain level was raised during the decay
+		if (segmentSamples < 1.f || (isAttack ? distance <= 0.f : distance >= 0.f))
+		{
+			level = target;
+			stage = isAttack ? Stage::decay : Stage::sustain;
+			continue;
+		}
+
+		const auto increment = (isAttack ? 1.f : sustain - 1.f) / segmentSamples;
+		const auto remaining = static_cast<int> (std::ceil (distance / increment));
+		const auto length	 = juce::jmin (numSamples, juce::jmax (1, remaining));
+
+		applyRamp (samples, length, level, increment);
+
+		samples += length;
+		numSamples -= length;
+
+		if (length < remaining)
+		{
+			level += increment * static_cast<float> (length);
+			return;
+		}
+
+		level = target;
+		stage = isAttack ? Stage::decay : Stage::sustain;
+	}
+}
+
+template <typename SampleType>
+void BlockEnvelope::applyRamp (SampleType* samples, int numSamples, float start, float increment) noexcept
+{
+	const auto first = static_cast<SampleType> (start);
+	const auto step	 = static_cast<SampleType> (increment);
+
+	for (int i = 0; i < numSamples; ++i)
+		samples[i] *= first + step * static_cast<SampleType> (i);
+}
+
+template void BlockEnvelope::apply (float*, int, const Settings&, double) noexcept;
+template void BlockEnvelope::apply (double*, int, const Settings&, double) noexcept;
+
+}  // namespace Imogen
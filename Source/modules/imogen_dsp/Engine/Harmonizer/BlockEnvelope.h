@@ -0,0 +1,46 @@
+#pragma once
+
+namespace Imogen
+{
+/* The attack, decay and sustain of a harmony voice, applied a block at a time.
+   The length of each segment is worked out up front, and each segment is then applied as a single linear ramp,
+   so there are no per-sample branches and the inner loops vectorize.
+   The release is left to the synth's own envelope, which ramps down from wherever this one is when the key is released.
+*/
+class BlockEnvelope
+{
+public:
+
+	struct Settings
+	{
+		float attackSeconds { 0.035f }, decaySeconds { 0.06f }, sustainLevel { 0.8f };
+	};
+
+	/* Restarts the attack from silence. */
+	void noteStarted() noexcept;
+
+	/* Holds the level wherever it is, so the synth's release ramps down from a steady level. */
+	void noteReleased() noexcept;
+
+	/* Multiplies the samples by the envelope. */
+	template <typename SampleType>
+	void apply (SampleType* samples, int numSamples, const Settings& settings, double samplerate) noexcept;
+
+private:
+
+	template <typename SampleType>
+	static void applyRamp (SampleType* samples, int numSamples, float start, float increment) noexcept;
+
+	enum class Stage
+	{
+		attack,
+		decay,
+		sustain,
+		released
+	};
+
+	Stage stage { Stage::attack };
+	float level { 0.f };
+};
+
+}  // namespace Imogen
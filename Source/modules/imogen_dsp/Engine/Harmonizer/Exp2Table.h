@@ -0,0 +1,38 @@
+#pragma once
+
+namespace Imogen
+{
+/* 2^x from a table of one octave plus linear interpolation, accurate to well under a cent.
+   Used to step pitch ramps without calling std::exp2 for every step.
+*/
+struct Exp2Table
+{
+	static float get (float x) noexcept
+	{
+		static const auto table = []
+		{
+			std::array<float, size + 1> values;
+
+			for (size_t i = 0; i < values.size(); ++i)
+				values[i] = std::exp2 (static_cast<float> (i) / static_cast<float> (size));
+
+			return values;
+		}();
+
+		const auto octave	= std::floor (x);
+		const auto position = (x - octave) * static_cast<float> (size);
+		const auto index	= juce::jmin (static_cast<int> (position), size - 1);
+		const auto fraction = position - static_cast<float> (index);
+
+		const auto lower = table[static_cast<size_t> (index)];
+		const auto upper = table[static_cast<size_t> (index + 1)];
+
+		return std::ldexp (lower + fraction * (upper - lower), static_cast<int> (octave));
+	}
+
+private:
+
+	static constexpr int size = 1024;
+};
+
+}  // namespace Imogen
@@ -0,0 +1,67 @@
+
+namespace Imogen
+{
+template <typename SampleType>
+void FormantCorrector<SampleType>::reset() noexcept
+{
+	for (auto& channel : channels)
+	{
+		channel.whitenState.fill (SampleType (0));
+		channel.recolourState.fill (SampleType (0));
+	}
+}
+
+template <typename SampleType>
+void FormantCorrector<SampleType>::process (juce::AudioBuffer<SampleType>& buffer, const Envelope& shiftedEnvelope, const Envelope& targetEnvelope) noexcept
+{
+	jassert (buffer.getNumChannels() <= maxChannels);
+
+	// whitening leaves the shifted envelope's prediction error, and recolouring divides by the target's
+	const auto gain = static_cast<SampleType> (std::sqrt (targetEnvelope.predictionError / juce::jmax (shiftedEnvelope.predictionError, 1.0e-6f)));
+
+	for (int chan = 0; chan < juce::jmin (buffer.getNumChannels(), maxChannels); ++chan)
+	{
+		auto& whitenState	= channels[static_cast<size_t> (chan)].whitenState;
+		auto& recolourState = channels[static_cast<size_t> (chan)].recolourState;
+
+		auto* samples = buffer.getWritePointer (chan);
+
+		for (int s = 0; s < buffer.getNumSamples(); ++s)
+		{
+			// whitening: each state holds the previous sample's backward error from that stage
+			auto forward  = samples[s];
+			auto backward = samples[s];
+
+			for (int m = 0; m < order; ++m)
+			{
+				const auto k = static_cast<SampleType> (shiftedEnvelope.reflection[static_cast<size_t> (m)]);
+
+				const auto lastBackward = whitenState[static_cast<size_t> (m)];
+				whitenState[static_cast<size_t> (m)] = backward;
+
+				backward = k * forward + lastBackward;
+				forward += k * lastBackward;
+			}
+
+			// recolouring runs the stages in reverse
+			for (int m = order; --m >= 0;)
+			{
+				const auto k = static_cast<SampleType> (targetEnvelope.reflection[static_cast<size_t> (m)]);
+
+				forward -= k * recolourState[static_cast<size_t> (m)];
+
+				if (m + 1 < order)
+					recolourState[static_cast<size_t> (m + 1)] = k * forward + recolourState[static_cast<size_t> (m)];
+			}
+
+			recolourState[0] = forward;
+
+			samples[s] = forward * gain;
+		}
+	}
+}
+
+template class FormantCorrector<float>;
+template class FormantCorrector<double>;
+
+}  // namespace Imogen
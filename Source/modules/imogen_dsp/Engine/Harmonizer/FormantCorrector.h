@@ -0,0 +1,34 @@
+#pragma once
+
+#include <imogen_dsp/Engine/Analysis/SpectralEnvelope.h>
+
+namespace Imogen
+{
+/* Moves a harmony voice's formants back to where they were in the input.
+   Its output is whitened with the envelope PSOLA shifted it to, then recoloured with the envelope it should have.
+   Both are lattice filters, so they stay stable when the envelopes change between analysis frames.
+*/
+template <typename SampleType>
+class FormantCorrector
+{
+public:
+
+	using Envelope = SpectralEnvelope::Envelope;
+
+	void reset() noexcept;
+
+	void process (juce::AudioBuffer<SampleType>& buffer, const Envelope& shiftedEnvelope, const Envelope& targetEnvelope) noexcept;
+
+private:
+
+	static constexpr int order = SpectralEnvelope::order, maxChannels = 2;
+
+	struct Channel
+	{
+		std::array<SampleType, order> whitenState {}, recolourState {};
+	};
+
+	std::array<Channel, maxChannels> channels;
+};
+
+}  // namespace Imogen
@@ -2,27 +2,59 @@
 namespace Imogen
 {
 template <typename SampleType>
-Harmonizer<SampleType>::Harmonizer (State& stateToUse, Analyzer& analyzerToUse)
+Harmonizer<SampleType>::Harmonizer (State& stateToUse, Analyzer& analyzerToUse, SpectralEnvelope& envelopeToUse)
 	: dsp::LambdaSynth<SampleType> ([this]
-									{ return new Voice (*this, analyzer); }),
-	  analyzer (analyzerToUse), state (stateToUse)
+									{
+										auto* voice = new Voice (*this, analyzer);
+										allVoices.add (voice);
+										return voice;
+									}),
+	  analyzer (analyzerToUse), spectralEnvelope (envelopeToUse), state (stateToUse)
 {
 	this->updateQuickReleaseMs (5);
 
 	this->playingButReleased.gain = 0.4f;
 	this->softPedal.gain		  = 0.65f;
+
+	noteChannels.fill (1);
 }
 
 template <typename SampleType>
-void Harmonizer<SampleType>::prepared (double, int blocksize)
+void Harmonizer<SampleType>::prepared (double samplerate, int blocksize)
 {
+	mtsEspCheckInterval		= juce::roundToInt (samplerate * 0.1);
+	samplesSinceMtsEspCheck = mtsEspCheckInterval;
+
 	wetBuffer.setSize (2, blocksize, true, true, true);
+
+	voiceTable.prepare (allVoices.size());
+
+	for (auto* voice : allVoices)
+	{
+		voice->prepareRendering (samplerate, blocksize);
+		voice->setMutedByLimit (false);
+	}
 }
 
 template <typename SampleType>
 void Harmonizer<SampleType>::process (int numSamples, MidiBuffer& midiMessages,
 									  bool harmoniesBypassed)
 {
+	++blockIndex;
+
+	notesStartedThisBlock.reset();
+
+	for (const auto metadata : midiMessages)
+	{
+		const auto message = metadata.getMessage();
+
+		if (message.isNoteOn())
+		{
+			notesStartedThisBlock.set (static_cast<size_t> (message.getNoteNumber()));
+			noteChannels[static_cast<size_t> (message.getNoteNumber())] = message.getChannel();
+		}
+	}
+
 	if (harmoniesBypassed)
 	{
 		wetBuffer.clear();
@@ -31,11 +63,21 @@ void Harmonizer<SampleType>::process (int numSamples, MidiBuffer& midiMessages,
 	else
 	{
 		updateParameters();
+		updateAutoHarmony();
 		this->renderVoices (midiMessages, wetBuffer);
 	}
 
-	updateInternals();
 	lastBlocksize = numSamples;
+	updateInternals();
+
+	updateVoiceNotes();
+	enforceVoiceLimit();
+}
+
+template <typename SampleType>
+void Harmonizer<SampleType>::setVoiceLimit (int maxVoices) noexcept
+{
+	voiceLimit = juce::jmax (1, maxVoices);
 }
 
 template <typename SampleType>
@@ -43,10 +85,18 @@ void Harmonizer<SampleType>::updateParameters()
 {
 	this->setMidiLatch (midi.midiLatch->get());
 
-	this->updateADSRsettings (midi.adsrAttack->get(),
-							  midi.adsrDecay->get(),
-							  static_cast<float> (midi.adsrSustain->get()) * 0.01f,
-							  midi.adsrRelease->get());
+	envelopeSettings.attackSeconds = midi.adsrAttack->get();
+	envelopeSettings.decaySeconds  = midi.adsrDecay->get();
+	envelopeSettings.sustainLevel  = static_cast<float> (midi.adsrSustain->get()) * 0.01f;
+
+	// each voice thickens its note into up to 8 copies, with up to 25 cents of drift
+	unisonSettings.numCopies   = unison.unisonVoices->get();
+	unisonSettings.detuneCents = static_cast<float> (unison.unisonDetune->get()) * 0.25f;
+
+	formantPreservation = static_cast<float> (parameters.formantPreservation->get()) * 0.01f;
+
+	// the voices apply the attack, decay and sustain themselves, so the synth's own envelope only handles the release
+	this->updateADSRsettings (0.f, 0.f, 1.f, midi.adsrRelease->get());
 
 	this->pedal.setParams (midi.pedalToggle->get(),
 						   midi.pedalThresh->get(),
@@ -69,16 +119,203 @@ void Harmonizer<SampleType>::updateParameters()
 	this->setPitchGlideTime (static_cast<double> (midi.glideTime->get()));
 }
 
+/*
+	The lead note is the one the engine detected in this block, whether or not the lead is being corrected.
+*/
+template <typename SampleType>
+void Harmonizer<SampleType>::updateAutoHarmony()
+{
+	auto chord = AutoHarmony::noChord;
+
+	if (autoHarmony.autoHarmonyToggle->get())
+	{
+		// while the lead is unpitched (between phrases, or on consonants) the last chord keeps playing
+		if (inputPitch < 0.f)
+			return;
+
+		// the lead has to move past the nearest semitone boundary by a margin before the chord follows it, so vibrato around a boundary doesn't flip between chords
+		if (autoLeadNote < 0 || std::abs (inputPitch - static_cast<float> (autoLeadNote)) > 0.5f + autoLeadNoteHysteresis)
+			autoLeadNote = juce::roundToInt (inputPitch);
+
+		chord = AutoHarmony::getChord (autoLeadNote,
+									   autoHarmony.autoHarmonyKey->get(),
+									   autoHarmony.autoHarmonyScale->get(),
+									   autoHarmony.autoHarmonyVoicing->get());
+	}
+	else
+	{
+		autoLeadNote = -1;
+	}
+
+	for (const auto note : autoChord)
+		if (note >= 0 && ! AutoHarmony::contains (chord, note))
+			this->noteOff (note, 1.f, true, false);
+
+	for (const auto note : chord)
+	{
+		if (note >= 0 && ! AutoHarmony::contains (autoChord, note))
+		{
+			this->noteOn (note, 1.f, false);
+			notesStartedThisBlock.set (static_cast<size_t> (note));
+		}
+	}
+
+	autoChord = chord;
+}
+
+template <typename SampleType>
+int Harmonizer<SampleType>::getFormantShift (float frequency) const noexcept
+{
+	if (inputPitch < 0.f || frequency <= 0.f)
+		return 0;
+
+	const auto semitones = 69.f + 12.f * std::log2 (frequency / 440.f) - inputPitch;
+
+	return juce::jlimit (-SpectralEnvelope::maxShiftSemitones, SpectralEnvelope::maxShiftSemitones, juce::roundToInt (semitones));
+}
+
 template <typename SampleType>
 void Harmonizer<SampleType>::updateInternals()
 {
-	auto ccInfo = this->getLastMovedControllerInfo();
-	internals.lastMovedMidiController->set (ccInfo.controllerNumber);
-	internals.lastMovedCCValue->set (ccInfo.controllerValue);
-	internals.mtsEspIsConnected->set (this->isConnectedToMtsEsp());
+	const auto ccInfo = this->getLastMovedControllerInfo();
+
+	lastMovedController = ccInfo.controllerNumber;
+	lastMovedCCValue	= ccInfo.controllerValue;
+
+	samplesSinceMtsEspCheck += lastBlocksize;
+
+	if (samplesSinceMtsEspCheck >= mtsEspCheckInterval)
+	{
+		samplesSinceMtsEspCheck = 0;
+		mtsEspConnected			= mtsEspTable.refresh();
+	}
+}
+
+template <typename SampleType>
+void Harmonizer<SampleType>::publishInternals()
+{
+	internals.lastMovedMidiController->set (lastMovedController);
+	internals.lastMovedCCValue->set (lastMovedCCValue);
+	internals.mtsEspIsConnected->set (mtsEspConnected);
+
 	//    internals.mtsEspScaleName->set (this->getScaleName());
 }
 
+template <typename SampleType>
+void Harmonizer<SampleType>::updateVoiceNotes()
+{
+	using Category = TraceRecorder::Category;
+	using Type	   = TraceRecorder::EventType;
+
+	const auto tracing	 = state.trace.isEnabled();
+	const auto numVoices = allVoices.size();
+
+	std::bitset<VoiceTable::numNotes> startedOnNewVoice;
+
+	for (int i = 0; i < numVoices; ++i)
+	{
+		auto*	   voice   = allVoices.getUnchecked (i);
+		const auto note	   = voiceTable.getNote (i);
+		const auto newNote = voice->isVoiceActive() ? voice->getCurrentlyPlayingNote() : -1;
+
+		if (newNote == note)
+			continue;
+
+		voice->setMutedByLimit (false);
+
+		if (note >= 0)
+		{
+			voiceTable.noteStopped (i);
+
+			if (tracing)
+				state.trace.record (Type::end, Category::voice, i, note);
+		}
+
+		if (newNote >= 0)
+		{
+			voiceTable.noteStarted (i, newNote);
+			startedOnNewVoice.set (static_cast<size_t> (newNote));
+
+			if (tracing)
+				state.trace.record (Type::begin, Category::voice, i, newNote);
+		}
+	}
+
+	// a note-on that no voice changed note for retriggered the voice already playing it, which starts over as the newest voice
+	for (int i = 0; i < numVoices; ++i)
+	{
+		const auto note = voiceTable.getNote (i);
+
+		if (note < 0 || ! notesStartedThisBlock[static_cast<size_t> (note)] || startedOnNewVoice[static_cast<size_t> (note)])
+			continue;
+
+		allVoices.getUnchecked (i)->setMutedByLimit (false);
+		voiceTable.noteStarted (i, note);
+
+		if (tracing)
+		{
+			state.trace.record (Type::end, Category::voice, i, note);
+			state.trace.record (Type::begin, Category::voice, i, note);
+		}
+	}
+}
+
+/*
+	The oldest held voices beyond the limit are muted rather than released, so that when the limit rises again
+	they fade back in on the notes the player is still holding. Voices in their release tail are left as they are.
+*/
+template <typename SampleType>
+void Harmonizer<SampleType>::enforceVoiceLimit()
+{
+	auto numHeld = 0;
+
+	for (auto i = voiceTable.getOldestVoice(); i >= 0; i = voiceTable.getNextNewer (i))
+		if (isVoiceHeld (i))
+			++numHeld;
+
+	auto numToMute = juce::jmax (0, numHeld - voiceLimit);
+
+	for (auto i = voiceTable.getOldestVoice(); i >= 0; i = voiceTable.getNextNewer (i))
+	{
+		if (! isVoiceHeld (i))
+			continue;
+
+		allVoices.getUnchecked (i)->setMutedByLimit (numToMute > 0);
+
+		if (numToMute > 0)
+			--numToMute;
+	}
+}
+
+template <typename SampleType>
+bool Harmonizer<SampleType>::isVoiceHeld (int voiceIndex) const
+{
+	auto* voice = allVoices.getUnchecked (voiceIndex);
+	return voice->isVoiceActive() && ! voice->isPlayingButReleased();
+}
+
+template <typename SampleType>
+void Harmonizer<SampleType>::getHeldNotes (std::bitset<VoiceTable::numNotes>& notes) const
+{
+	notes.reset();
+
+	for (auto i = voiceTable.getOldestVoice(); i >= 0; i = voiceTable.getNextNewer (i))
+		if (isVoiceHeld (i) && ! allVoices.getUnchecked (i)->isMutedByLimit())
+			notes.set (static_cast<size_t> (voiceTable.getNote (i)));
+}
+
+template <typename SampleType>
+float Harmonizer<SampleType>::getTuningRatio (int midiNote) const noexcept
+{
+	if (mtsEspConnected)
+		return mtsEspTable.getFrequencyRatio (midiNote, noteChannels[static_cast<size_t> (juce::jlimit (0, VoiceTable::numNotes - 1, midiNote))]);
+
+	if (! state.tuning.hasScale())
+		return 1.f;
+
+	return static_cast<float> (state.tuning.getFrequencyRatio (midiNote));
+}
+
 template <typename SampleType>
 AudioBuffer<SampleType>& Harmonizer<SampleType>::getHarmonySignal()
 {
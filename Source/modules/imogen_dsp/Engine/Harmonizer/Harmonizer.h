@@ -5,6 +5,9 @@
 #include <lemons_psola/lemons_psola.h>
 
 #include "HarmonizerVoice.h"
+#include "VoiceTable.h"
+#include "MtsEspTable.h"
+#include "AutoHarmony/AutoHarmony.h"
 
 
 namespace Imogen
@@ -18,7 +21,10 @@ class Harmonizer : public dsp::LambdaSynth<SampleType>
 
 public:
 
-	Harmonizer (State& stateToUse, Analyzer& analyzerToUse);
+	/* The size of the voice pool. */
+	static constexpr int numVoices = 16;
+
+	Harmonizer (State& stateToUse, Analyzer& analyzerToUse, SpectralEnvelope& envelopeToUse);
 
 	void process (int		  numSamples,
 				  MidiBuffer& midiMessages,
@@ -26,24 +32,110 @@ public:
 
 	AudioBuffer& getHarmonySignal();
 
+	/* Beyond this many held voices, the oldest ones are muted, and they're unmuted once the limit allows them again. */
+	void setVoiceLimit (int maxVoices) noexcept;
+
+	/* Sets a bit for each note that has a voice playing it whose key hasn't been released, and that the voice limit hasn't muted. */
+	void getHeldNotes (std::bitset<VoiceTable::numNotes>& notes) const;
+
+	/* How far the tuning retunes this note, from the MTS-ESP master's table if one is connected, otherwise from the local scale. */
+	float getTuningRatio (int midiNote) const noexcept;
+
+	/* The attack, decay and sustain, which the voices apply themselves. */
+	const BlockEnvelope::Settings& getEnvelopeSettings() const noexcept { return envelopeSettings; }
+
+	const typename Unison<SampleType>::Settings& getUnisonSettings() const noexcept { return unisonSettings; }
+
+	/* While the input is unvoiced, the voices fade out and stop shifting. */
+	void setInputVoiced (bool isVoiced) noexcept { inputVoiced = isVoiced; }
+	bool isInputVoiced() const noexcept { return inputVoiced; }
+
+	/* The input's pitch in this block, as a fractional MIDI note, or -1 if it has none. */
+	void  setInputPitch (float midiPitch) noexcept { inputPitch = midiPitch; }
+	float getInputPitch() const noexcept { return inputPitch; }
+
+	/* How many semitones a voice at this frequency is above the input's pitch, or 0 if the input has no pitch. */
+	int getFormantShift (float frequency) const noexcept;
+
+	/* How much of each voice's formant shift to undo, from 0 to 1. */
+	float getFormantPreservation() const noexcept { return formantPreservation; }
+
+	/* Shared by all the voices; analyzed by the engine alongside the analyzer. */
+	SpectralEnvelope& getSpectralEnvelope() noexcept { return spectralEnvelope; }
+
+	/* Publishes the last moved controller and the MTS-ESP connection to the internals. Call from the audio thread. */
+	void publishInternals();
+
+	/* Counts calls to process(). */
+	juce::uint64 getBlockIndex() const noexcept { return blockIndex; }
+
 	Analyzer& analyzer;
 
 private:
 
+	SpectralEnvelope& spectralEnvelope;
+
 	void prepared (double samplerate, int blocksize) final;
 
 	void updateParameters();
 	void updateInternals();
 
-	State&		state;
-	Parameters& parameters { state.parameters };
-	MidiState&	midi { parameters.midiState };
-	Internals&	internals { state.internals };
+	void updateAutoHarmony();
+
+	void updateVoiceNotes();
+	void enforceVoiceLimit();
+
+	bool isVoiceHeld (int voiceIndex) const;
+
+	State&			  state;
+	Parameters&		  parameters { state.parameters };
+	MidiState&		  midi { parameters.midiState };
+	AutoHarmonyState& autoHarmony { parameters.autoHarmonyState };
+	UnisonState&	  unison { parameters.unisonState };
+	Internals&		  internals { state.internals };
 
 	AudioBuffer wetBuffer;
 	AudioBuffer alias;
 
 	int lastBlocksize { 0 };
+
+	juce::uint64 blockIndex { 0 };
+
+	bool inputVoiced { true };
+
+	BlockEnvelope::Settings envelopeSettings;
+
+	typename Unison<SampleType>::Settings unisonSettings;
+
+	float inputPitch { -1.f }, formantPreservation { 0.f };
+
+	// the MTS-ESP connection is checked, and its table refreshed, about ten times a second rather than every block
+	bool		mtsEspConnected { false };
+	MtsEspTable mtsEspTable;
+
+	/* The channel each note was last started on, which picks the MTS-ESP table it's retuned by. */
+	std::array<int, VoiceTable::numNotes> noteChannels;
+
+	int lastMovedController { -1 }, lastMovedCCValue { 0 };
+	int	 samplesSinceMtsEspCheck { 0 }, mtsEspCheckInterval { 4410 };
+
+	/* Every voice the synth has created, in creation order; the synth itself owns them. */
+	juce::Array<Voice*> allVoices;
+
+	/* The note each voice was playing at the end of the last block. */
+	VoiceTable voiceTable;
+
+	// a note-on for a note a voice is already playing may retrigger that voice without changing its note
+	std::bitset<VoiceTable::numNotes> notesStartedThisBlock;
+
+	int voiceLimit { std::numeric_limits<int>::max() };
+
+	/* The notes the auto harmony is currently holding down. */
+	AutoHarmony::Chord autoChord { AutoHarmony::noChord };
+
+	/* The lead note the auto harmony's chord is built on, and how far past a semitone boundary the lead has to go to change it. */
+	int				   autoLeadNote { -1 };
+	static constexpr float autoLeadNoteHysteresis = 0.3f;
 };
 
 
@@ -3,17 +3,202 @@ namespace Imogen
 {
 template <typename SampleType>
 HarmonizerVoice<SampleType>::HarmonizerVoice (Harmonizer<SampleType>& h, dsp::psola::Analyzer<SampleType>& analyzerToUse)
-	: dsp::SynthVoiceBase<SampleType> (&h), shifter (analyzerToUse)
+	: dsp::SynthVoiceBase<SampleType> (&h), harmonizer (h), shifter (analyzerToUse)
 {
 }
 
+template <typename SampleType>
+void HarmonizerVoice<SampleType>::prepareRendering (double samplerate, int blocksize)
+{
+	unison.prepare (samplerate);
+
+	uncorrected.setSize (2, blocksize);
+
+	formantMix.reset (samplerate, 0.02);
+	formantMix.setCurrentAndTargetValue (SampleType (0));
+
+	voicedGain.reset (samplerate, 0.01);
+	voicedGain.setCurrentAndTargetValue (SampleType (1));
+}
+
 template <typename SampleType>
 void HarmonizerVoice<SampleType>::renderPlease (AudioBuffer& output, float desiredFrequency, double currentSamplerate)
 {
 	jassert (desiredFrequency > 0 && currentSamplerate > 0);
 
-	shifter.setPitch (desiredFrequency, currentSamplerate);
-	shifter.getSamples (output);
+	const auto note		= this->getCurrentlyPlayingNote();
+	const auto block	= harmonizer.getBlockIndex();
+	const auto released = this->isPlayingButReleased();
+
+	// a voice that skipped a whole block was idle, so whatever it's playing now is a new note;
+	// so is one whose key was released and is down again, even on the same note
+	if (note != lastNote || lastRenderedBlock + 1 < block || (wasReleased && ! released))
+	{
+		envelope.noteStarted();
+		unison.reset();
+		formants.reset();
+		lastFrequency = 0.f;
+	}
+
+	lastNote		  = note;
+	lastRenderedBlock = block;
+	wasReleased		  = released;
+
+	if (released)
+		envelope.noteReleased();
+
+	voicedGain.setTargetValue (harmonizer.isInputVoiced() && ! mutedByLimit ? SampleType (1) : SampleType (0));
+
+	if (voicedGain.isSmoothing() || voicedGain.getTargetValue() > SampleType (0))
+	{
+		const auto frequency = desiredFrequency * harmonizer.getTuningRatio (note);
+
+		renderPitchRamp (output, frequency, currentSamplerate);
+
+		applyFormantCorrection (output, frequency);
+
+		unison.process (output, harmonizer.getUnisonSettings());
+
+		applyVoicedFade (output);
+	}
+	else
+	{
+		// nothing is shifted while the voice is faded out; it starts again from the current pitch
+		output.clear();
+		unison.reset();
+		formants.reset();
+		lastFrequency = 0.f;
+	}
+
+	applyEnvelope (output, currentSamplerate);
+}
+
+/*
+	The synth only updates each voice's frequency once per block, so glides and pitch bends would step at the block rate.
+	Instead the block is rendered in short steps that ramp exponentially from the last block's frequency to this one's.
+*/
+template <typename SampleType>
+void HarmonizerVoice<SampleType>::renderPitchRamp (AudioBuffer& output, float frequency, double currentSamplerate)
+{
+	const auto numSamples = output.getNumSamples();
+	const auto numSteps	  = numSamples / pitchRampStepSamples;
+
+	if (numSteps < 2 || lastFrequency <= 0.f || lastFrequency == frequency)
+	{
+		shifter.setPitch (frequency, currentSamplerate);
+		shifter.getSamples (output);
+
+		lastFrequency = frequency;
+		return;
+	}
+
+	const auto octaves = std::log2 (frequency / lastFrequency);
+
+	for (int step = 0; step < numSteps; ++step)
+	{
+		const auto start = step * numSamples / numSteps;
+		const auto end	 = (step + 1) * numSamples / numSteps;
+
+		rampAlias.setDataToReferTo (output.getArrayOfWritePointers(), output.getNumChannels(), start, end - start);
+
+		const auto progress = static_cast<float> (step + 1) / static_cast<float> (numSteps);
+
+		shifter.setPitch (lastFrequency * Exp2Table::get (octaves * progress), currentSamplerate);
+		shifter.getSamples (rampAlias);
+	}
+
+	lastFrequency = frequency;
+}
+
+/*
+	PSOLA shifts the formants along with the pitch. The voice's output is whitened with the input's envelope shifted by the same interval,
+	and recoloured with the envelope shifted by whatever part of the interval isn't being preserved.
+*/
+template <typename SampleType>
+void HarmonizerVoice<SampleType>::applyFormantCorrection (AudioBuffer& output, float frequency)
+{
+	const auto shift	= harmonizer.getFormantShift (frequency);
+	const auto residual = juce::roundToInt (static_cast<float> (shift) * (1.f - harmonizer.getFormantPreservation()));
+
+	const auto isCorrecting = shift != residual;
+
+	if (isCorrecting)
+	{
+		correctedShift	  = shift;
+		correctedResidual = residual;
+	}
+
+	formantMix.setTargetValue (isCorrecting ? SampleType (1) : SampleType (0));
+
+	if (! formantMix.isSmoothing() && ! isCorrecting)
+	{
+		formants.reset();
+		return;
+	}
+
+	const auto numChannels = output.getNumChannels();
+	const auto numSamples  = output.getNumSamples();
+
+	// without room to keep the uncorrected signal, the correction can only switch straight on or off
+	const auto canCrossfade = formantMix.isSmoothing() && numChannels <= uncorrected.getNumChannels() && numSamples <= uncorrected.getNumSamples();
+
+	if (canCrossfade)
+		for (int chan = 0; chan < numChannels; ++chan)
+			uncorrected.copyFrom (chan, 0, output, chan, 0, numSamples);
+
+	auto& spectralEnvelope = harmonizer.getSpectralEnvelope();
+
+	formants.process (output, spectralEnvelope.getEnvelope (correctedShift), spectralEnvelope.getEnvelope (correctedResidual));
+
+	if (! canCrossfade)
+	{
+		formantMix.setCurrentAndTargetValue (formantMix.getTargetValue());
+		return;
+	}
+
+	auto* const* channels = output.getArrayOfWritePointers();
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const auto mix = formantMix.getNextValue();
+
+		for (int chan = 0; chan < numChannels; ++chan)
+		{
+			const auto dry = uncorrected.getSample (chan, i);
+			channels[chan][i] = dry + mix * (channels[chan][i] - dry);
+		}
+	}
+}
+
+template <typename SampleType>
+void HarmonizerVoice<SampleType>::applyVoicedFade (AudioBuffer& output)
+{
+	if (! voicedGain.isSmoothing())
+		return;
+
+	const auto numChannels = output.getNumChannels();
+
+	auto* const* channels = output.getArrayOfWritePointers();
+
+	for (int i = 0; i < output.getNumSamples(); ++i)
+	{
+		const auto gain = voicedGain.getNextValue();
+
+		for (int chan = 0; chan < numChannels; ++chan)
+			channels[chan][i] *= gain;
+	}
+}
+
+template <typename SampleType>
+void HarmonizerVoice<SampleType>::applyEnvelope (AudioBuffer& output, double currentSamplerate)
+{
+	const auto start = envelope;
+
+	for (int chan = 0; chan < output.getNumChannels(); ++chan)
+	{
+		envelope = start;
+		envelope.apply (output.getWritePointer (chan), output.getNumSamples(), harmonizer.getEnvelopeSettings(), currentSamplerate);
+	}
 }
 
 template class HarmonizerVoice<float>;
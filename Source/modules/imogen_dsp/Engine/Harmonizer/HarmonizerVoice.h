@@ -1,6 +1,11 @@
 
 #pragma once
 
+#include "BlockEnvelope.h"
+#include "Exp2Table.h"
+#include "Unison.h"
+#include "FormantCorrector.h"
+
 
 namespace Imogen
 {
@@ -19,10 +24,54 @@ public:
 
 	HarmonizerVoice (Harmonizer<SampleType>& h, dsp::psola::Analyzer<SampleType>& analyzerToUse);
 
+	void prepareRendering (double samplerate, int blocksize);
+
+	/* A voice muted by the voice limit keeps its note, but fades out and stops rendering until it's unmuted. */
+	void setMutedByLimit (bool shouldBeMuted) noexcept { mutedByLimit = shouldBeMuted; }
+	bool isMutedByLimit() const noexcept { return mutedByLimit; }
+
 private:
 
 	void renderPlease (AudioBuffer& output, float desiredFrequency, double currentSamplerate) final;
 
+	void renderPitchRamp (AudioBuffer& output, float frequency, double currentSamplerate);
+	void applyEnvelope (AudioBuffer& output, double currentSamplerate);
+	void applyVoicedFade (AudioBuffer& output);
+	void applyFormantCorrection (AudioBuffer& output, float frequency);
+
+	static constexpr int pitchRampStepSamples = 32;
+
+	Harmonizer<SampleType>& harmonizer;
+
+	BlockEnvelope envelope;
+
+	Unison<SampleType> unison;
+
+	FormantCorrector<SampleType> formants;
+
+	// crossfades between the uncorrected and corrected output, so switching the formant correction on or off doesn't click
+	juce::SmoothedValue<SampleType> formantMix { SampleType (0) };
+
+	// the intervals last corrected, which are kept while the correction fades out
+	int correctedShift { 0 }, correctedResidual { 0 };
+
+	AudioBuffer uncorrected;
+
+	// fades the voice out while the input is unvoiced, or while the voice limit mutes it
+	juce::SmoothedValue<SampleType> voicedGain { SampleType (1) };
+
+	bool mutedByLimit { false };
+
+	// used to spot when the voice starts a new note
+	int			 lastNote { -1 };
+	juce::uint64 lastRenderedBlock { 0 };
+	bool		 wasReleased { false };
+
+	// the frequency the last block ended on, or 0 at the start of a note
+	float lastFrequency { 0.f };
+
+	AudioBuffer rampAlias;
+
 	dsp::psola::Shifter<SampleType> shifter;
 };
 
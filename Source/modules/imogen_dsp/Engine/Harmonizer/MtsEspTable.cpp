@@ -0,0 +1,46 @@
+#include <libMTSClient.h>
+
+namespace Imogen
+{
+MtsEspTable::MtsEspTable()
+	: client (MTS_RegisterClient())
+{
+	for (auto& channel : ratios)
+		channel.fill (1.f);
+}
+
+MtsEspTable::~MtsEspTable()
+{
+	MTS_DeregisterClient (client);
+}
+
+bool MtsEspTable::refresh() noexcept
+{
+	if (client == nullptr || ! MTS_HasMaster (client))
+	{
+		if (connected)
+			for (auto& channel : ratios)
+				channel.fill (1.f);
+
+		connected = false;
+		return false;
+	}
+
+	connected = true;
+
+	for (int channel = 0; channel < numChannels; ++channel)
+		for (int note = 0; note < numNotes; ++note)
+			ratios[static_cast<size_t> (channel)][static_cast<size_t> (note)] = static_cast<float> (MTS_RetuningAsRatio (client, static_cast<char> (note), static_cast<char> (channel)));
+
+	return true;
+}
+
+float MtsEspTable::getFrequencyRatio (int midiNote, int midiChannel) const noexcept
+{
+	if (! juce::isPositiveAndBelow (midiNote, numNotes) || ! juce::isPositiveAndBelow (midiChannel - 1, numChannels))
+		return 1.f;
+
+	return ratios[static_cast<size_t> (midiChannel - 1)][static_cast<size_t> (midiNote)];
+}
+
+}  // namespace Imogen
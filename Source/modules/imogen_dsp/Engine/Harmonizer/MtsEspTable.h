@@ -0,0 +1,35 @@
+#pragma once
+
+class MTSClient;
+
+namespace Imogen
+{
+/* A copy of an MTS-ESP master's tuning: how far it retunes each note on each MIDI channel, away from 12-tone equal temperament.
+   The harmonizer refreshes it about ten times a second, so the voices look their retuning up in the table rather than asking
+   the master for it. MTS-ESP doesn't say when the master retunes, so each refresh reads the whole table again.
+*/
+class MtsEspTable
+{
+public:
+
+	static constexpr int numChannels = 16, numNotes = 128;
+
+	MtsEspTable();
+	~MtsEspTable();
+
+	/* Returns true if a master is connected, after copying its tuning into the table. Call from the audio thread. */
+	bool refresh() noexcept;
+
+	/* Channels are 1 to 16. Returns 1 if no master was connected at the last refresh. */
+	float getFrequencyRatio (int midiNote, int midiChannel) const noexcept;
+
+private:
+
+	MTSClient* client { nullptr };
+
+	bool connected { false };
+
+	std::array<std::array<float, numNotes>, numChannels> ratios;
+};
+
+}  // namespace Imogen
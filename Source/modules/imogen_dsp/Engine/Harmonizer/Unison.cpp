@@ -0,0 +1,127 @@
+
+namespace Imogen
+{
+template <typename SampleType>
+void Unison<SampleType>::prepare (double samplerateToUse)
+{
+	samplerate = samplerateToUse;
+
+	// room for the longest base delay plus its modulation
+	const auto size = juce::nextPowerOfTwo (juce::roundToInt (samplerate * 0.05));
+
+	delayLine.setSize (1, size);
+	delayLine.clear();
+
+	mask	   = size - 1;
+	writeIndex = 0;
+	wasActive  = false;
+
+	for (size_t i = 0; i < copies.size(); ++i)
+	{
+		auto& copy = copies[i];
+
+		const auto rate	 = 0.17 + 0.11 * static_cast<double> (i);
+		const auto phase = 2.39996 * static_cast<double> (i);  // the golden angle, so the copies start spread out
+
+		copy.baseDelay		= static_cast<SampleType> (samplerate * (0.007 + 0.016 * static_cast<double> (i) / (maxCopies - 1)));
+		copy.sine			= static_cast<SampleType> (std::sin (phase));
+		copy.cosine			= static_cast<SampleType> (std::cos (phase));
+		copy.rotationSine	= static_cast<SampleType> (std::sin (juce::MathConstants<double>::twoPi * rate / samplerate));
+		copy.rotationCosine = static_cast<SampleType> (std::cos (juce::MathConstants<double>::twoPi * rate / samplerate));
+	}
+}
+
+template <typename SampleType>
+void Unison<SampleType>::updateCopies (const Settings& settings)
+{
+	// a delay modulated by depth * sin (2 pi f t) shifts the pitch by up to 2 pi f depth / samplerate
+	const auto pitchDeviation = std::exp2 (static_cast<double> (settings.detuneCents) / 1200.) - 1.;
+
+	// the copies are uncorrelated enough that their powers add
+	sectionGain = static_cast<SampleType> (1. / std::sqrt (static_cast<double> (settings.numCopies)));
+
+	for (int i = 1; i < settings.numCopies; ++i)
+	{
+		auto& copy = copies[static_cast<size_t> (i)];
+
+		// stops rounding errors from slowly changing the oscillator's amplitude
+		const auto amplitude = std::sqrt (copy.sine * copy.sine + copy.cosine * copy.cosine);
+		copy.sine /= amplitude;
+		copy.cosine /= amplitude;
+
+		const auto rate = 0.17 + 0.11 * static_cast<double> (i);
+
+		copy.depth = juce::jmin (static_cast<SampleType> (pitchDeviation * samplerate / (juce::MathConstants<double>::twoPi * rate)),
+								 copy.baseDelay - SampleType (2));
+	}
+}
+
+template <typename SampleType>
+SampleType Unison<SampleType>::readDelayed (SampleType delaySamples) const noexcept
+{
+	const auto whole	= static_cast<int> (delaySamples);
+	const auto fraction = delaySamples - static_cast<SampleType> (whole);
+
+	const auto* line = delayLine.getReadPointer (0);
+
+	const auto newer = line[(writeIndex - whole) & mask];
+	const auto older = line[(writeIndex - whole - 1) & mask];
+
+	return newer + fraction * (older - newer);
+}
+
+template <typename SampleType>
+void Unison<SampleType>::process (AudioBuffer& audio, const Settings& settings)
+{
+	const auto isActive = settings.numCopies > 1 && isPrepared();
+
+	if (! isActive)
+	{
+		wasActive = false;
+		return;
+	}
+
+	if (! wasActive)
+		delayLine.clear();
+
+	wasActive = true;
+
+	const auto numChannels = audio.getNumChannels();
+	const auto numSamples  = audio.getNumSamples();
+	const auto numCopies   = juce::jmin (settings.numCopies, maxCopies);
+
+	updateCopies (settings);
+
+	auto* line	= delayLine.getWritePointer (0);
+	auto* first = audio.getWritePointer (0);
+
+	for (int s = 0; s < numSamples; ++s)
+	{
+		line[writeIndex] = first[s];
+
+		auto sum = first[s];
+
+		for (int i = 1; i < numCopies; ++i)
+		{
+			auto& copy = copies[static_cast<size_t> (i)];
+
+			sum += readDelayed (copy.baseDelay + copy.depth * copy.sine);
+
+			const auto sine = copy.sine * copy.rotationCosine + copy.cosine * copy.rotationSine;
+			copy.cosine		= copy.cosine * copy.rotationCosine - copy.sine * copy.rotationSine;
+			copy.sine		= sine;
+		}
+
+		first[s] = sum * sectionGain;
+
+		writeIndex = (writeIndex + 1) & mask;
+	}
+
+	for (int chan = 1; chan < numChannels; ++chan)
+		audio.copyFrom (chan, 0, audio, 0, 0, numSamples);
+}
+
+template class Unison<float>;
+template class Unison<double>;
+
+}  // namespace Imogen
@@ -0,0 +1,63 @@
+#pragma once
+
+namespace Imogen
+{
+/* Turns one rendered voice into a small section: the original plus up to seven copies, each read from a shared delay line
+   at its own slowly modulated delay, so that each copy drifts slightly in time and pitch.
+   The voices render in mono and the synth pans each one as a whole, so the copies aren't spread across the stereo field.
+*/
+template <typename SampleType>
+class Unison
+{
+public:
+
+	using AudioBuffer = juce::AudioBuffer<SampleType>;
+
+	static constexpr int maxCopies = 8;
+
+	struct Settings
+	{
+		// including the original
+		int numCopies { 1 };
+
+		float detuneCents { 7.5f };
+	};
+
+	void prepare (double samplerate);
+
+	bool isPrepared() const noexcept { return mask > 0; }
+
+	/* Forgets the audio in the delay line, e.g. at the start of a new note. */
+	void reset() noexcept { wasActive = false; }
+
+	/* Takes the input from the first channel, and writes the section to every channel. */
+	void process (AudioBuffer& audio, const Settings& settings);
+
+private:
+
+	void updateCopies (const Settings& settings);
+
+	struct Copy
+	{
+		SampleType baseDelay { 0 }, depth { 0 };
+
+		// a sine oscillator, advanced by rotating its phase one sample at a time
+		SampleType sine { 0 }, cosine { 1 }, rotationSine { 0 }, rotationCosine { 1 };
+	};
+
+	SampleType readDelayed (SampleType delaySamples) const noexcept;
+
+	double samplerate { 44100. };
+
+	AudioBuffer delayLine;
+	int			writeIndex { 0 }, mask { 0 };
+
+	std::array<Copy, maxCopies> copies;
+
+	SampleType sectionGain { 1 };
+
+	// the delay line is cleared whenever unison is switched on or reset, so copies never start with stale audio
+	bool wasActive { false };
+};
+
+}  // namespace Imogen
@@ -0,0 +1,83 @@
+
+namespace Imogen
+{
+void VoiceTable::prepare (int numVoices)
+{
+	entries.clearQuick();
+	entries.insertMultiple (0, {}, numVoices);
+
+	oldest	   = -1;
+	newest	   = -1;
+	numPlaying = 0;
+}
+
+bool VoiceTable::isValidVoice (int voiceIndex) const noexcept
+{
+	return juce::isPositiveAndBelow (voiceIndex, entries.size());
+}
+
+void VoiceTable::noteStarted (int voiceIndex, int note) noexcept
+{
+	if (! isValidVoice (voiceIndex) || ! juce::isPositiveAndBelow (note, numNotes))
+		return;
+
+	noteStopped (voiceIndex);
+
+	auto& entry = entries.getReference (voiceIndex);
+
+	entry.note	= note;
+	entry.older = newest;
+	entry.newer = -1;
+
+	if (newest >= 0)
+		entries.getReference (newest).newer = voiceIndex;
+	else
+		oldest = voiceIndex;
+
+	newest = voiceIndex;
+
+	++numPlaying;
+}
+
+void VoiceTable::noteStopped (int voiceIndex) noexcept
+{
+	if (! isValidVoice (voiceIndex))
+		return;
+
+	auto& entry = entries.getReference (voiceIndex);
+
+	if (entry.note < 0)
+		return;
+
+	if (entry.older >= 0)
+		entries.getReference (entry.older).newer = entry.newer;
+	else
+		oldest = entry.newer;
+
+	if (entry.newer >= 0)
+		entries.getReference (entry.newer).older = entry.older;
+	else
+		newest = entry.older;
+
+	entry = {};
+
+	--numPlaying;
+}
+
+int VoiceTable::getNote (int voiceIndex) const noexcept
+{
+	if (! isValidVoice (voiceIndex))
+		return -1;
+
+	return entries.getReference (voiceIndex).note;
+}
+
+int VoiceTable::getNextNewer (int voiceIndex) const noexcept
+{
+	if (! isValidVoice (voiceIndex))
+		return -1;
+
+	return entries.getReference (voiceIndex).newer;
+}
+
+}  // namespace Imogen
@@ -0,0 +1,48 @@
+#pragma once
+
+namespace Imogen
+{
+/* Keeps the note each of the harmonizer's voices is playing, in the order the notes started, so that the voice limit
+   can mute the oldest voices without sorting. It's only an index for that: the harmonizer still checks every voice
+   once a block to keep it up to date. Voices are referred to by their index in the harmonizer's voice list.
+*/
+class VoiceTable
+{
+public:
+
+	static constexpr int numNotes = 128;
+
+	/* Allocates space for the given number of voices, and forgets every note. */
+	void prepare (int numVoices);
+
+	void noteStarted (int voiceIndex, int note) noexcept;
+	void noteStopped (int voiceIndex) noexcept;
+
+	/* Returns -1 if the voice isn't playing anything. */
+	int getNote (int voiceIndex) const noexcept;
+
+	/* Walk from the oldest playing voice to the newest; each returns -1 at the end. */
+	int getOldestVoice() const noexcept { return oldest; }
+	int getNextNewer (int voiceIndex) const noexcept;
+
+	int getNumVoicesPlaying() const noexcept { return numPlaying; }
+
+private:
+
+	struct Entry
+	{
+		int note { -1 };
+		int older { -1 }, newer { -1 };
+	};
+
+	bool isValidVoice (int voiceIndex) const noexcept;
+
+	juce::Array<Entry> entries;
+
+	// notes only ever start at the newest end, so a linked list keeps the voices in age order without any sorting
+	int oldest { -1 }, newest { -1 };
+
+	int numPlaying { 0 };
+};
+
+}  // namespace Imogen
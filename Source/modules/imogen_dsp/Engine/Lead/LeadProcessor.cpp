@@ -3,7 +3,7 @@ namespace Imogen
 {
 template <typename SampleType>
 LeadProcessor<SampleType>::LeadProcessor (Harmonizer<SampleType>& harm, State& stateToUse)
-	: pitchCorrector (harm, stateToUse.internals), dryPanner (stateToUse.parameters)
+	: pitchCorrector (harm), dryPanner (stateToUse.parameters)
 {
 }
 
@@ -12,18 +12,58 @@ void LeadProcessor<SampleType>::prepare (double samplerate, int blocksize)
 {
 	pannedLeadBuffer.setSize (2, blocksize, true, true, true);
 
+	correctionAmount.reset (samplerate, 0.05);
+
 	dryPanner.prepare (samplerate, blocksize);
 	pitchCorrector.prepare (samplerate, blocksize);
 }
 
 template <typename SampleType>
-void LeadProcessor<SampleType>::process (bool leadIsBypassed, int numSamples)
+void LeadProcessor<SampleType>::process (bool leadIsBypassed, const SampleType* dryInput, int numSamples)
 {
-	pitchCorrector.renderNextFrame (numSamples);
-	dryPanner.process (pitchCorrector.getCorrectedSignal(), pannedLeadBuffer, leadIsBypassed);
+	dryPanner.process (getLeadSignal (dryInput, numSamples), pannedLeadBuffer, leadIsBypassed);
 	lastBlocksize = numSamples;
 }
 
+template <typename SampleType>
+const juce::AudioBuffer<SampleType>& LeadProcessor<SampleType>::getLeadSignal (const SampleType* dryInput, int numSamples)
+{
+	correctionAmount.setTargetValue (correctionAllowed && inputVoiced ? SampleType (1) : SampleType (0));
+
+	if (correctionAmount.isSmoothing() || correctionAmount.getTargetValue() > SampleType (0))
+		pitchCorrector.renderNextFrame (numSamples);
+
+	if (! correctionAmount.isSmoothing())
+	{
+		if (correctionAmount.getTargetValue() > SampleType (0))
+			return pitchCorrector.getCorrectedSignal();
+
+		dryAlias.setDataToReferTo (const_cast<SampleType**> (&dryInput), 1, numSamples);
+		return dryAlias;
+	}
+
+	// the corrected signal is dead once it's blended, so the blend is written over it
+	auto& corrected = pitchCorrector.getCorrectedSignal();
+	auto* blended	= corrected.getWritePointer (0);
+
+	for (int i = 0; i < numSamples; ++i)
+		blended[i] = dryInput[i] + correctionAmount.getNextValue() * (blended[i] - dryInput[i]);
+
+	return corrected;
+}
+
+template <typename SampleType>
+void LeadProcessor<SampleType>::setPitchCorrectionAllowed (bool shouldBeAllowed) noexcept
+{
+	correctionAllowed = shouldBeAllowed;
+}
+
+template <typename SampleType>
+void LeadProcessor<SampleType>::setInputVoiced (bool isVoiced) noexcept
+{
+	inputVoiced = isVoiced;
+}
+
 template <typename SampleType>
 juce::AudioBuffer<SampleType>& LeadProcessor<SampleType>::getProcessedSignal()
 {
@@ -19,18 +19,32 @@ public:
 
 	void prepare (double samplerate, int blocksize);
 
-	void process (bool leadIsBypassed, int numSamples);
+	void process (bool leadIsBypassed, const SampleType* dryInput, int numSamples);
+
+	/* When not allowed, pitch correction is skipped and the lead crossfades to the dry input. */
+	void setPitchCorrectionAllowed (bool shouldBeAllowed) noexcept;
+
+	/* Unvoiced input is never corrected, in the same way. */
+	void setInputVoiced (bool isVoiced) noexcept;
 
 	AudioBuffer& getProcessedSignal();
 
 private:
 
+	const AudioBuffer& getLeadSignal (const SampleType* dryInput, int numSamples);
+
 	PitchCorrection<SampleType> pitchCorrector;
 	DryPanner<SampleType>		dryPanner;
 
 	AudioBuffer pannedLeadBuffer;
 	AudioBuffer alias;
 
+	AudioBuffer dryAlias;
+
+	juce::SmoothedValue<SampleType> correctionAmount { SampleType (1) };
+
+	bool correctionAllowed { true }, inputVoiced { true };
+
 	int lastBlocksize { 0 };
 };
 
@@ -2,8 +2,8 @@
 namespace Imogen
 {
 template <typename SampleType>
-PitchCorrection<SampleType>::PitchCorrection (Harmonizer<SampleType>& harm, Internals& internalsToUse)
-	: Base (harm.analyzer, harm.getPitchAdjuster()), internals (internalsToUse)
+PitchCorrection<SampleType>::PitchCorrection (Harmonizer<SampleType>& harm)
+	: Base (harm.analyzer, harm.getPitchAdjuster())
 {
 }
 
@@ -13,13 +13,10 @@ void PitchCorrection<SampleType>::renderNextFrame (int numSamples)
 	alias.setDataToReferTo (correctedBuffer.getArrayOfWritePointers(), 1, numSamples);
 
 	this->processNextFrame (alias);
-
-	internals.currentInputNote->set (this->getOutputMidiPitch());
-	internals.currentCentsSharp->set (this->getCentsSharp());
 }
 
 template <typename SampleType>
-const juce::AudioBuffer<SampleType>& PitchCorrection<SampleType>::getCorrectedSignal() const
+juce::AudioBuffer<SampleType>& PitchCorrection<SampleType>::getCorrectedSignal()
 {
 	return alias;
 }
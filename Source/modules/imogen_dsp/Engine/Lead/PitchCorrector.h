@@ -12,18 +12,17 @@ public:
 	using AudioBuffer = juce::AudioBuffer<SampleType>;
 	using Base		  = dsp::psola::PitchCorrectorBase<SampleType>;
 
-	PitchCorrection (Harmonizer<SampleType>& harm, Internals& internalsToUse);
+	PitchCorrection (Harmonizer<SampleType>& harm);
 
 	void renderNextFrame (int numSamples);
 
 	void prepare (double samplerate, int blocksize);
 
-	const AudioBuffer& getCorrectedSignal() const;
+	/* The lead processor may overwrite this in place; it isn't read again until the next frame is rendered. */
+	AudioBuffer& getCorrectedSignal();
 
 private:
 
-	Internals& internals;
-
 	AudioBuffer correctedBuffer;
 	AudioBuffer alias;
 };
@@ -0,0 +1,122 @@
+
+namespace Imogen
+{
+void MidiOutputGenerator::prepare()
+{
+	events.ensureSize (reservedBytes);
+	eventsHeldBy = nullptr;
+
+	harmonyNotes.reset();
+	leadNoteHeld  = -1;
+	lastPitchbend = 8192;
+}
+
+void MidiOutputGenerator::process (const NoteSet& heldHarmonyNotes, int leadNote, int leadCentsSharp, MidiBuffer& midiMessages)
+{
+	takeBackEvents (midiMessages);
+	events.clear();
+
+	updateHarmonyNotes (heldHarmonyNotes);
+	updateLead (leadNote, leadCentsSharp);
+
+	handOverEvents (midiMessages);
+}
+
+void MidiOutputGenerator::takeBackEvents (MidiBuffer& midiMessages)
+{
+	// after this, the reserved buffer holds this block's own messages
+	if (eventsHeldBy == &midiMessages)
+		events.swapWith (midiMessages);
+
+	eventsHeldBy = nullptr;
+}
+
+void MidiOutputGenerator::handOverEvents (MidiBuffer& midiMessages)
+{
+	midiMessages.swapWith (events);
+	eventsHeldBy = &midiMessages;
+}
+
+bool MidiOutputGenerator::addIfRoom (const juce::MidiMessage& message)
+{
+	if (static_cast<size_t> (events.data.size()) + bytesPerEvent > reservedBytes)
+		return false;
+
+	events.addEvent (message, 0);
+	return true;
+}
+
+void MidiOutputGenerator::updateHarmonyNotes (const NoteSet& heldNotes)
+{
+	for (size_t note = 0; note < heldNotes.size(); ++note)
+	{
+		if (heldNotes[note] == harmonyNotes[note])
+			continue;
+
+		if (heldNotes[note])
+			events.addEvent (juce::MidiMessage::noteOn (harmonyChannel, static_cast<int> (note), velocity), 0);
+		else
+			events.addEvent (juce::MidiMessage::noteOff (harmonyChannel, static_cast<int> (note)), 0);
+	}
+
+	harmonyNotes = heldNotes;
+}
+
+void MidiOutputGenerator::updateLead (int leadNote, int leadCentsSharp)
+{
+	if (leadNote != leadNoteHeld)
+	{
+		if (leadNoteHeld >= 0)
+			events.addEvent (juce::MidiMessage::noteOff (leadChannel, leadNoteHeld), 0);
+
+		leadNoteHeld = leadNote;
+
+		if (leadNoteHeld >= 0)
+			events.addEvent (juce::MidiMessage::noteOn (leadChannel, leadNoteHeld, velocity), 0);
+	}
+
+	if (leadNoteHeld < 0)
+		return;
+
+	const auto pitchbend = juce::jlimit (0, 16383, 8192 + juce::roundToInt (static_cast<float> (leadCentsSharp) / 200.f * 8191.f));
+
+	if (pitchbend == lastPitchbend)
+		return;
+
+	lastPitchbend = pitchbend;
+	events.addEvent (juce::MidiMessage::pitchWheel (leadChannel, pitchbend), 0);
+}
+
+void MidiOutputGenerator::releaseAll (MidiBuffer& midiMessages)
+{
+	// if the reserved buffer isn't the one this block is in, as much of the block as its spare room takes is copied into it
+	if (eventsHeldBy != &midiMessages)
+	{
+		events.clear();
+
+		for (const auto metadata : midiMessages)
+			if (static_cast<size_t> (events.data.size()) + sizeof (juce::int32) + sizeof (juce::uint16) + static_cast<size_t> (metadata.numBytes) <= reservedBytes - maxBytesPerBlock)
+				events.addEvent (metadata.data, metadata.numBytes, metadata.samplePosition);
+	}
+
+	takeBackEvents (midiMessages);
+
+	for (size_t note = 0; note < harmonyNotes.size(); ++note)
+		if (harmonyNotes[note] && addIfRoom (juce::MidiMessage::noteOff (harmonyChannel, static_cast<int> (note))))
+			harmonyNotes.reset (note);
+
+	if (leadNoteHeld >= 0 && addIfRoom (juce::MidiMessage::noteOff (leadChannel, leadNoteHeld)))
+		leadNoteHeld = -1;
+
+	if (lastPitchbend != 8192 && addIfRoom (juce::MidiMessage::pitchWheel (leadChannel, 8192)))
+		lastPitchbend = 8192;
+
+	handOverEvents (midiMessages);
+}
+
+bool MidiOutputGenerator::hasNotesHeld() const noexcept
+{
+	return harmonyNotes.any() || leadNoteHeld >= 0 || lastPitchbend != 8192;
+}
+
+}  // namespace Imogen
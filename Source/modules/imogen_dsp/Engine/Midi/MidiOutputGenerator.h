@@ -0,0 +1,63 @@
+#pragma once
+
+#include <bitset>
+#include <imogen_dsp/Engine/Harmonizer/VoiceTable.h>
+
+namespace Imogen
+{
+/* Turns the notes the harmonizer is playing, and the lead's detected pitch, into MIDI for driving other instruments.
+   Harmony notes go out on channel 1; the lead goes out on channel 2 as a note plus pitch bend (with a range of +/- 2 semitones).
+   Events are built into a buffer reserved in prepare(), which is then swapped into the buffer the engine renders into, and taken back
+   at the start of the next block. The engine renders into the same buffer every block, so the host's buffer never has to grow.
+*/
+class MidiOutputGenerator
+{
+public:
+
+	static constexpr int harmonyChannel = 1, leadChannel = 2;
+
+	/* The most that process() or releaseAll() adds in one block: every harmony note changing at once, plus a lead note-off,
+	   note-on and pitch bend. A MidiBuffer stores each 3-byte message after a 4-byte timestamp and a 2-byte size. */
+	static constexpr int	maxEventsPerBlock = VoiceTable::numNotes + 3;
+	static constexpr size_t bytesPerEvent	  = 3 + sizeof (juce::int32) + sizeof (juce::uint16);
+	static constexpr size_t maxBytesPerBlock  = maxEventsPerBlock * bytesPerEvent;
+
+	/* releaseAll() keeps the block's own messages, so the reserved buffer also has room for some of those. */
+	static constexpr size_t reservedBytes = maxBytesPerBlock + 1024;
+
+	void prepare();
+
+	using NoteSet = std::bitset<VoiceTable::numNotes>;
+
+	/* Replaces the contents of the MIDI buffer with any notes that started or stopped since the last block.
+	   Pass -1 as the lead note when the input is unpitched. */
+	void process (const NoteSet& heldHarmonyNotes, int leadNote, int leadCentsSharp, MidiBuffer& midiMessages);
+
+	/* Sends note-offs for anything still held, e.g. when MIDI output is switched off, after the block's own messages.
+	   Any that don't fit in the reserved buffer are sent in the next block. */
+	void releaseAll (MidiBuffer& midiMessages);
+
+	bool hasNotesHeld() const noexcept;
+
+private:
+
+	void updateHarmonyNotes (const NoteSet& heldNotes);
+	void updateLead (int leadNote, int leadCentsSharp);
+
+	void takeBackEvents (MidiBuffer& midiMessages);
+	void handOverEvents (MidiBuffer& midiMessages);
+	bool addIfRoom (const juce::MidiMessage& message);
+
+	static constexpr juce::uint8 velocity = 100;
+
+	MidiBuffer events;
+
+	MidiBuffer* eventsHeldBy { nullptr };
+
+	NoteSet harmonyNotes;
+
+	int leadNoteHeld { -1 };
+	int lastPitchbend { 8192 };
+};
+
+}  // namespace Imogen
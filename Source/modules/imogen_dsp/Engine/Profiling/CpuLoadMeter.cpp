@@ -0,0 +1,73 @@
+
+namespace Imogen
+{
+CpuLoadMeter::CpuLoadMeter (Meters& metersToUse, FlightRecorder& recorderToUse)
+	: meters (metersToUse), recorder (recorderToUse)
+{
+}
+
+void CpuLoadMeter::prepare (double samplerateToUse, int hostBlocksize)
+{
+	samplerate	 = samplerateToUse;
+	maxBlocksize = juce::jmax (1, hostBlocksize);
+
+	peakHoldSamples = juce::roundToInt (samplerate * 2.);
+
+	lastLoad		 = 0.;
+	smoothedLoad	 = 0.;
+	peakLoad		 = 0.;
+	samplesSincePeak = 0;
+	numOverruns		 = 0;
+
+	meters.cpuLoad->set (0);
+	meters.cpuLoadPeak->set (0);
+	meters.blockOverruns->set (0);
+}
+
+void CpuLoadMeter::blockFinished (double secondsTaken, int numSamples) noexcept
+{
+	if (numSamples <= 0)
+		return;
+
+	// a chunk larger than the host's blocks still has to be rendered within one host block
+	const auto budget = static_cast<double> (juce::jmin (numSamples, maxBlocksize)) / samplerate;
+	const auto load	  = secondsTaken / budget;
+
+	lastLoad = load;
+
+	recorder.recordLoad (load);
+
+	if (load > 1.)
+		meters.blockOverruns->set (++numOverruns);
+
+	// about 300 ms of smoothing, independent of the blocksize
+	const auto coeff = std::exp (-static_cast<double> (numSamples) / (0.3 * samplerate));
+
+	smoothedLoad = load + coeff * (smoothedLoad - load);
+
+	samplesSincePeak += numSamples;
+
+	if (load >= peakLoad || samplesSincePeak > peakHoldSamples)
+	{
+		peakLoad		 = load;
+		samplesSincePeak = 0;
+	}
+
+	meters.cpuLoad->set (juce::roundToInt (smoothedLoad * 100.));
+	meters.cpuLoadPeak->set (juce::roundToInt (peakLoad * 100.));
+}
+
+
+CpuLoadMeter::ScopedMeasurement::ScopedMeasurement (CpuLoadMeter& meterToUse, int numSamplesInBlock) noexcept
+	: meter (meterToUse), numSamples (numSamplesInBlock), start (std::chrono::steady_clock::now())
+{
+}
+
+CpuLoadMeter::ScopedMeasurement::~ScopedMeasurement()
+{
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	meter.blockFinished (elapsed.count(), numSamples);
+}
+
+}  // namespace Imogen
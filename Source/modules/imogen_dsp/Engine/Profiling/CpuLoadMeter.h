@@ -0,0 +1,54 @@
+#pragma once
+
+#include <imogen_state/imogen_state.h>
+
+namespace Imogen
+{
+/* Measures how long each block takes to render against its real-time budget,
+   and writes the smoothed load, a held peak and the number of blocks that went over budget into the Meters.
+   Each block's load is also passed on to the flight recorder.
+*/
+class CpuLoadMeter
+{
+public:
+
+	CpuLoadMeter (Meters& metersToUse, FlightRecorder& recorderToUse);
+
+	void prepare (double samplerate, int hostBlocksize);
+
+	/* Returns the unsmoothed load of the last block measured, where 1 means it took its entire budget. */
+	double getLastLoad() const noexcept { return lastLoad; }
+
+	struct ScopedMeasurement
+	{
+		ScopedMeasurement (CpuLoadMeter& meterToUse, int numSamplesInBlock) noexcept;
+		~ScopedMeasurement();
+
+	private:
+
+		CpuLoadMeter& meter;
+		const int	  numSamples;
+
+		const std::chrono::steady_clock::time_point start;
+
+		JUCE_DECLARE_NON_COPYABLE (ScopedMeasurement)
+	};
+
+private:
+
+	void blockFinished (double secondsTaken, int numSamples) noexcept;
+
+	Meters&			meters;
+	FlightRecorder& recorder;
+
+	double samplerate { 44100. };
+	int	   maxBlocksize { 512 };
+
+	double lastLoad { 0. }, smoothedLoad { 0. }, peakLoad { 0. };
+
+	int samplesSincePeak { 0 }, peakHoldSamples { 0 };
+
+	int numOverruns { 0 };
+};
+
+}  // namespace Imogen
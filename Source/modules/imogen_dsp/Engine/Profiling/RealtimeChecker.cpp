@@ -0,0 +1,246 @@
+
+#if JUCE_LINUX || JUCE_MAC
+#	include <execinfo.h>
+#	include <unistd.h>
+#endif
+
+#if JUCE_LINUX
+#	include <dlfcn.h>
+#endif
+
+namespace Imogen
+{
+namespace RealtimeCheckerState
+{
+static thread_local int	 realtimeDepth { 0 };
+static thread_local bool reporting { false };
+
+static std::atomic<int>	 numViolations { 0 };
+static std::atomic<bool> abortOnViolation { false };
+
+// past this many, violations are still counted but their stacks aren't printed
+static constexpr int maxReportedStacks = 32;
+
+static void writeToStderr (const char* text) noexcept
+{
+#if JUCE_LINUX || JUCE_MAC
+	juce::ignoreUnused (::write (STDERR_FILENO, text, std::strlen (text)));
+#else
+	std::fputs (text, stderr);
+#endif
+}
+
+static void writeBacktrace() noexcept
+{
+#if JUCE_LINUX || JUCE_MAC
+	void* frames[64];
+
+	const auto numFrames = ::backtrace (frames, 64);
+
+	// skips this function and reportViolation()
+	::backtrace_symbols_fd (frames + 2, numFrames - 2, STDERR_FILENO);
+#else
+	std::fputs (juce::SystemStats::getStackBacktrace().toRawUTF8(), stderr);
+#endif
+}
+}  // namespace RealtimeCheckerState
+
+
+RealtimeChecker::ScopedRealtime::ScopedRealtime() noexcept
+{
+	++RealtimeCheckerState::realtimeDepth;
+}
+
+RealtimeChecker::ScopedRealtime::~ScopedRealtime()
+{
+	--RealtimeCheckerState::realtimeDepth;
+}
+
+bool RealtimeChecker::isInRealtimeScope() noexcept
+{
+	using namespace RealtimeCheckerState;
+
+	return realtimeDepth > 0;
+}
+
+void RealtimeChecker::reportViolation (const char* what) noexcept
+{
+	using namespace RealtimeCheckerState;
+
+	if (reporting || ! isInRealtimeScope())
+		return;
+
+	// anything the report itself does is ignored
+	reporting = true;
+
+	const auto index = numViolations++;
+
+	if (index < maxReportedStacks)
+	{
+		writeToStderr ("\n*** Realtime safety violation: ");
+		writeToStderr (what);
+		writeToStderr (" on the audio thread\n");
+		writeBacktrace();
+	}
+
+	if (abortOnViolation.load())
+		std::abort();
+
+	reporting = false;
+}
+
+int RealtimeChecker::getNumViolations() noexcept
+{
+	return RealtimeCheckerState::numViolations.load();
+}
+
+void RealtimeChecker::resetViolations() noexcept
+{
+	RealtimeCheckerState::numViolations.store (0);
+}
+
+void RealtimeChecker::setAbortOnViolation (bool shouldAbort) noexcept
+{
+	RealtimeCheckerState::abortOnViolation.store (shouldAbort);
+}
+
+}  // namespace Imogen
+
+
+#if IMOGEN_RT_CHECK
+
+#	if JUCE_LINUX && defined(__GLIBC__)
+
+/* glibc exports its allocator under these names, so the malloc interceptors can forward to them without dlsym(),
+   which would itself allocate. The other functions are looked up the first time they're called. */
+extern "C"
+{
+	void* __libc_malloc (size_t);
+	void* __libc_calloc (size_t, size_t);
+	void* __libc_realloc (void*, size_t);
+	void  __libc_free (void*);
+
+	static int (*realMutexLock) (pthread_mutex_t*)											  = nullptr;
+	static int (*realCondWait) (pthread_cond_t*, pthread_mutex_t*)							  = nullptr;
+	static int (*realCondTimedWait) (pthread_cond_t*, pthread_mutex_t*, const struct timespec*) = nullptr;
+	static int (*realNanosleep) (const struct timespec*, struct timespec*)					  = nullptr;
+
+	void* malloc (size_t size)
+	{
+		Imogen::RealtimeChecker::reportViolation ("malloc");
+		return __libc_malloc (size);
+	}
+
+	void* calloc (size_t num, size_t size)
+	{
+		Imogen::RealtimeChecker::reportViolation ("calloc");
+		return __libc_calloc (num, size);
+	}
+
+	void* realloc (void* ptr, size_t size)
+	{
+		Imogen::RealtimeChecker::reportViolation ("realloc");
+		return __libc_realloc (ptr, size);
+	}
+
+	void free (void* ptr)
+	{
+		if (ptr != nullptr)
+			Imogen::RealtimeChecker::reportViolation ("free");
+
+		__libc_free (ptr);
+	}
+
+	int pthread_mutex_lock (pthread_mutex_t* mutex)
+	{
+		Imogen::RealtimeChecker::reportViolation ("pthread_mutex_lock");
+
+		if (realMutexLock == nullptr)
+			realMutexLock = reinterpret_cast<decltype (realMutexLock)> (dlsym (RTLD_NEXT, "pthread_mutex_lock"));
+
+		return realMutexLock (mutex);
+	}
+
+	// juce::WaitableEvent and std::condition_variable both wait with these
+	int pthread_cond_wait (pthread_cond_t* condition, pthread_mutex_t* mutex)
+	{
+		Imogen::RealtimeChecker::reportViolation ("pthread_cond_wait");
+
+		if (realCondWait == nullptr)
+			realCondWait = reinterpret_cast<decltype (realCondWait)> (dlsym (RTLD_NEXT, "pthread_cond_wait"));
+
+		return realCondWait (condition, mutex);
+	}
+
+	int pthread_cond_timedwait (pthread_cond_t* condition, pthread_mutex_t* mutex, const struct timespec* deadline)
+	{
+		Imogen::RealtimeChecker::reportViolation ("pthread_cond_timedwait");
+
+		if (realCondTimedWait == nullptr)
+			realCondTimedWait = reinterpret_cast<decltype (realCondTimedWait)> (dlsym (RTLD_NEXT, "pthread_cond_timedwait"));
+
+		return realCondTimedWait (condition, mutex, deadline);
+	}
+
+	int nanosleep (const struct timespec* duration, struct timespec* remaining)
+	{
+		Imogen::RealtimeChecker::reportViolation ("nanosleep");
+
+		if (realNanosleep == nullptr)
+			realNanosleep = reinterpret_cast<decltype (realNanosleep)> (dlsym (RTLD_NEXT, "nanosleep"));
+
+		return realNanosleep (duration, remaining);
+	}
+}
+
+#	else
+
+void* operator new (std::size_t size)
+{
+	Imogen::RealtimeChecker::reportViolation ("operator new");
+
+	if (auto* ptr = std::malloc (size == 0 ? 1 : size))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)
+{
+	Imogen::RealtimeChecker::reportViolation ("operator new[]");
+
+	if (auto* ptr = std::malloc (size == 0 ? 1 : size))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void operator delete (void* ptr) noexcept
+{
+	if (ptr != nullptr)
+		Imogen::RealtimeChecker::reportViolation ("operator delete");
+
+	std::free (ptr);
+}
+
+void operator delete[] (void* ptr) noexcept
+{
+	if (ptr != nullptr)
+		Imogen::RealtimeChecker::reportViolation ("operator delete[]");
+
+	std::free (ptr);
+}
+
+void operator delete (void* ptr, std::size_t) noexcept
+{
+	operator delete (ptr);
+}
+
+void operator delete[] (void* ptr, std::size_t) noexcept
+{
+	operator delete[] (ptr);
+}
+
+#	endif
+
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+
+namespace Imogen
+{
+/* When the engine is built with IMOGEN_RT_CHECK enabled, any allocation, deallocation, mutex lock, condition wait or sleep
+   made by a thread while it's inside a realtime scope is reported to stderr, along with the stack that made it.
+   On Linux the malloc family, pthread_mutex_lock, pthread_cond_wait, pthread_cond_timedwait and nanosleep are intercepted;
+   elsewhere only operator new and delete are.
+*/
+struct RealtimeChecker
+{
+	struct ScopedRealtime
+	{
+		ScopedRealtime() noexcept;
+		~ScopedRealtime();
+
+		JUCE_DECLARE_NON_COPYABLE (ScopedRealtime)
+	};
+
+	static bool isInRealtimeScope() noexcept;
+
+	static void reportViolation (const char* what) noexcept;
+
+	static int	getNumViolations() noexcept;
+	static void resetViolations() noexcept;
+
+	static void setAbortOnViolation (bool shouldAbort) noexcept;
+};
+
+}  // namespace Imogen
+
+
+#if IMOGEN_RT_CHECK
+#	define IMOGEN_REALTIME_SCOPE const ::Imogen::RealtimeChecker::ScopedRealtime JUCE_JOIN_MACRO (imogenRealtimeScope_, __LINE__)
+#else
+#	define IMOGEN_REALTIME_SCOPE
+#endif
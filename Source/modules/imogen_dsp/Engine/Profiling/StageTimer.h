@@ -0,0 +1,49 @@
+#pragma once
+
+#include <imogen_state/imogen_state.h>
+
+namespace Imogen
+{
+/* Records how long it was alive into one of the State's stage timing histograms,
+   and marks its beginning and end in the State's trace, if that's recording.
+*/
+class ScopedStageTimer
+{
+public:
+
+	ScopedStageTimer (State& stateToUse, StageTimings::Stage stageToTime) noexcept
+		: timings (stateToUse.stageTimings),
+		  trace (stateToUse.trace, TraceRecorder::Category::stage, static_cast<int> (stageToTime)),
+		  stage (stageToTime),
+		  start (Clock::now())
+	{
+	}
+
+	~ScopedStageTimer()
+	{
+		const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds> (Clock::now() - start);
+
+		timings.record (stage, static_cast<juce::uint64> (elapsed.count()));
+	}
+
+private:
+
+	using Clock = std::chrono::steady_clock;
+
+	StageTimings&		   timings;
+	const ScopedTraceEvent trace;
+	StageTimings::Stage	   stage;
+	Clock::time_point	   start;
+
+	JUCE_DECLARE_NON_COPYABLE (ScopedStageTimer)
+};
+
+}  // namespace Imogen
+
+
+#if IMOGEN_STAGE_TIMING
+#	define IMOGEN_TIME_STAGE(state, stageName) \
+		const ::Imogen::ScopedStageTimer JUCE_JOIN_MACRO (imogenStageTimer_, __LINE__) { state, ::Imogen::StageTimings::Stage::stageName }
+#else
+#	define IMOGEN_TIME_STAGE(state, stageName)
+#endif
@@ -0,0 +1,225 @@
+
+namespace Imogen
+{
+template <typename SampleType>
+void InternalRateConverter<SampleType>::setFactor (int newFactor)
+{
+	jassert (newFactor > 0);
+
+	factor	= newFactor;
+	numTaps = factor * tapsPerPhase;
+
+	designFilter();
+}
+
+template <typename SampleType>
+int InternalRateConverter<SampleType>::chooseFactor (double hostSamplerate, double internalSamplerate)
+{
+	jassert (internalSamplerate > 0.);
+
+	return juce::jmax (1, static_cast<int> (std::floor (hostSamplerate / internalSamplerate + 0.1)));
+}
+
+template <typename SampleType>
+int InternalRateConverter<SampleType>::getLatencySamples() const noexcept
+{
+	// group delay of the decimation & interpolation filters, plus the primed output FIFO
+	return (numTaps - 1) + (factor - 1);
+}
+
+template <typename SampleType>
+int InternalRateConverter<SampleType>::getMaxInternalBlocksize() const noexcept
+{
+	return maxHostSamples / factor + 1;
+}
+
+template <typename SampleType>
+void InternalRateConverter<SampleType>::prepare (int numChannels, int maxHostBlocksize)
+{
+	maxHostSamples = maxHostBlocksize;
+
+	decimatorHistory.setSize (numChannels, numTaps - 1 + maxHostBlocksize);
+	decimatorHistory.clear();
+	decimatorFill		= numTaps - 1;
+	nextDecimatorOutput = numTaps - 1;
+
+	interpolatorHistory.setSize (numChannels, tapsPerPhase - 1 + getMaxInternalBlocksize());
+	interpolatorHistory.clear();
+
+	// the primed samples, up to factor - 1 left over from the last block, and a whole block's worth of new ones
+	outputFifo.setSize (numChannels, 2 * (factor - 1) + factor * getMaxInternalBlocksize());
+	outputFifo.clear();
+	outputFifoFill = factor - 1;
+}
+
+template <typename SampleType>
+void InternalRateConverter<SampleType>::designFilter()
+{
+	// Kaiser-windowed sinc lowpass, with its transition band placed just below the internal Nyquist frequency,
+	// so that nothing above it can alias into the internal stream
+	constexpr auto beta = 8.;
+
+	// Kaiser's estimates of the attenuation this beta gives, and the transition width it takes with this many taps
+	const auto attenuation = beta / 0.1102 + 8.7;
+	const auto transition  = (attenuation - 7.95) / (14.36 * static_cast<double> (numTaps - 1));
+
+	const auto cutoff = (0.5 - 0.5 * transition * static_cast<double> (factor)) / static_cast<double> (factor);
+	const auto centre = static_cast<double> (numTaps - 1) * 0.5;
+
+	const auto besselI0 = [] (double x)
+	{
+		auto sum = 1., term = 1.;
+
+		for (int k = 1; k < 32; ++k)
+		{
+			const auto t = x / (2. * k);
+			term *= t * t;
+			sum += term;
+		}
+
+		return sum;
+	};
+
+	std::vector<double> h (static_cast<size_t> (numTaps));
+
+	auto sum = 0.;
+
+	for (int n = 0; n < numTaps; ++n)
+	{
+		const auto x	  = static_cast<double> (n) - centre;
+		const auto sinc	  = x == 0. ? 1. : std::sin (juce::MathConstants<double>::twoPi * cutoff * x) / (juce::MathConstants<double>::twoPi * cutoff * x);
+		const auto ratio  = x / (centre + 1.);
+		const auto window = besselI0 (beta * std::sqrt (juce::jmax (0., 1. - ratio * ratio))) / besselI0 (beta);
+
+		h[static_cast<size_t> (n)] = 2. * cutoff * sinc * window;
+		sum += h[static_cast<size_t> (n)];
+	}
+
+	// taps are stored reversed, so that each output sample is a forward dot product over the history
+	decimatorTaps.resize (static_cast<size_t> (numTaps));
+
+	for (int n = 0; n < numTaps; ++n)
+		decimatorTaps[static_cast<size_t> (n)] = static_cast<SampleType> (h[static_cast<size_t> (numTaps - 1 - n)] / sum);
+
+	// phase p of the interpolator uses taps p, p + factor, p + 2*factor..., scaled by the factor to make up for the zero-stuffing
+	interpolatorTaps.resize (static_cast<size_t> (numTaps));
+
+	for (int phase = 0; phase < factor; ++phase)
+		for (int j = 0; j < tapsPerPhase; ++j)
+			interpolatorTaps[static_cast<size_t> (phase * tapsPerPhase + j)] = static_cast<SampleType> (h[static_cast<size_t> ((tapsPerPhase - 1 - j) * factor + phase)] / sum * factor);
+}
+
+template <typename SampleType>
+int InternalRateConverter<SampleType>::downsample (const AudioBuffer& hostIn, AudioBuffer& internalOut)
+{
+	const auto numSamples  = hostIn.getNumSamples();
+	const auto numChannels = juce::jmin (hostIn.getNumChannels(), decimatorHistory.getNumChannels(), internalOut.getNumChannels());
+
+	jassert (numSamples <= maxHostSamples);
+
+	const auto* taps = decimatorTaps.data();
+
+	int numOutputs = 0;
+	int nextOutput = nextDecimatorOutput;
+
+	for (int chan = 0; chan < numChannels; ++chan)
+	{
+		auto* history = decimatorHistory.getWritePointer (chan);
+		auto* out	  = internalOut.getWritePointer (chan);
+
+		juce::FloatVectorOperations::copy (history + decimatorFill, hostIn.getReadPointer (chan), numSamples);
+
+		const auto fill = decimatorFill + numSamples;
+
+		nextOutput = nextDecimatorOutput;
+		numOutputs = 0;
+
+		for (; nextOutput < fill; nextOutput += factor)
+		{
+			const auto* window = history + nextOutput - (numTaps - 1);
+
+			SampleType y = 0;
+
+			for (int j = 0; j < numTaps; ++j)
+				y += taps[j] * window[j];
+
+			out[numOutputs++] = y;
+		}
+
+		const auto keepFrom = nextOutput - (numTaps - 1);
+
+		std::memmove (history, history + keepFrom, sizeof (SampleType) * static_cast<size_t> (fill - keepFrom));
+	}
+
+	const auto keepFrom = nextOutput - (numTaps - 1);
+
+	decimatorFill		= decimatorFill + numSamples - keepFrom;
+	nextDecimatorOutput = nextOutput - keepFrom;
+
+	return numOutputs;
+}
+
+template <typename SampleType>
+void InternalRateConverter<SampleType>::upsample (const AudioBuffer& internalIn, int numInternalSamples, AudioBuffer& hostOut)
+{
+	const auto numSamples  = hostOut.getNumSamples();
+	const auto numChannels = juce::jmin (internalIn.getNumChannels(), interpolatorHistory.getNumChannels(), hostOut.getNumChannels());
+
+	jassert (numInternalSamples <= getMaxInternalBlocksize());
+
+	const auto* taps = interpolatorTaps.data();
+
+	const auto newFifoFill = outputFifoFill + numInternalSamples * factor;
+	const auto numToRead   = juce::jmin (numSamples, newFifoFill);
+
+	jassert (newFifoFill <= outputFifo.getNumSamples());
+	jassert (numToRead == numSamples);
+
+	for (int chan = 0; chan < numChannels; ++chan)
+	{
+		auto* history = interpolatorHistory.getWritePointer (chan);
+		auto* fifo	  = outputFifo.getWritePointer (chan);
+
+		juce::FloatVectorOperations::copy (history + tapsPerPhase - 1, internalIn.getReadPointer (chan), numInternalSamples);
+
+		auto* fifoWrite = fifo + outputFifoFill;
+
+		for (int i = 0; i < numInternalSamples; ++i)
+		{
+			const auto* window = history + i;
+
+			for (int phase = 0; phase < factor; ++phase)
+			{
+				const auto* phaseTaps = taps + phase * tapsPerPhase;
+
+				SampleType y = 0;
+
+				for (int j = 0; j < tapsPerPhase; ++j)
+					y += phaseTaps[j] * window[j];
+
+				*fifoWrite++ = y;
+			}
+		}
+
+		std::memmove (history, history + numInternalSamples, sizeof (SampleType) * static_cast<size_t> (tapsPerPhase - 1));
+
+		auto* out = hostOut.getWritePointer (chan);
+
+		juce::FloatVectorOperations::copy (out, fifo, numToRead);
+
+		if (numToRead < numSamples)
+			juce::FloatVectorOperations::clear (out + numToRead, numSamples - numToRead);
+
+		std::memmove (fifo, fifo + numToRead, sizeof (SampleType) * static_cast<size_t> (newFifoFill - numToRead));
+	}
+
+	for (int chan = numChannels; chan < hostOut.getNumChannels(); ++chan)
+		hostOut.clear (chan, 0, numSamples);
+
+	outputFifoFill = newFifoFill - numToRead;
+}
+
+template class InternalRateConverter<float>;
+template class InternalRateConverter<double>;
+
+}  // namespace Imogen
@@ -0,0 +1,57 @@
+#pragma once
+
+namespace Imogen
+{
+/* Converts between the host samplerate and a fixed internal samplerate that is an integer fraction of it.
+   Both directions use a windowed-sinc polyphase FIR; the inner loops are plain dot products over contiguous
+   arrays, so they are vectorized by the compiler.
+   Blocks of any size can be passed in: leftover input samples are carried over to the next block, and the
+   upsampled output is read from a FIFO that is primed with (factor - 1) samples of silence.
+*/
+template <typename SampleType>
+class InternalRateConverter
+{
+public:
+
+	using AudioBuffer = juce::AudioBuffer<SampleType>;
+
+	void setFactor (int newFactor);
+
+	void prepare (int numChannels, int maxHostBlocksize);
+
+	int getFactor() const noexcept { return factor; }
+
+	int getLatencySamples() const noexcept;
+
+	int getMaxInternalBlocksize() const noexcept;
+
+	/* Returns the number of internal-rate samples written to internalOut. */
+	int downsample (const AudioBuffer& hostIn, AudioBuffer& internalOut);
+
+	void upsample (const AudioBuffer& internalIn, int numInternalSamples, AudioBuffer& hostOut);
+
+	static int chooseFactor (double hostSamplerate, double internalSamplerate);
+
+private:
+
+	void designFilter();
+
+	// enough for a stopband of about 80 dB that starts at the internal Nyquist frequency, with a passband up to about 0.39 of the internal rate
+	static constexpr int tapsPerPhase = 48;
+
+	int factor { 1 }, numTaps { tapsPerPhase };
+
+	int maxHostSamples { 0 };
+
+	std::vector<SampleType> decimatorTaps, interpolatorTaps;
+
+	AudioBuffer decimatorHistory;
+	int			decimatorFill { 0 }, nextDecimatorOutput { 0 };
+
+	AudioBuffer interpolatorHistory;
+
+	AudioBuffer outputFifo;
+	int			outputFifoFill { 0 };
+};
+
+}  // namespace Imogen
@@ -0,0 +1,111 @@
+
+namespace Imogen
+{
+AudioWorker::AudioWorker (const juce::String& threadName, Job&& jobToRun)
+	: juce::Thread (threadName), job (std::move (jobToRun))
+{
+}
+
+AudioWorker::~AudioWorker()
+{
+	stop();
+}
+
+void AudioWorker::start()
+{
+	if (! isThreadRunning())
+		startThread (realtimeAudioPriority);
+}
+
+void AudioWorker::stop()
+{
+	if (! isThreadRunning())
+		return;
+
+	stopThread (1000);
+
+	jobPending = false;
+	jobsFinished.store (jobsLaunched.load());
+}
+
+bool AudioWorker::isRunning() const
+{
+	return isThreadRunning();
+}
+
+bool AudioWorker::isBusy() noexcept
+{
+	if (jobPending && jobsFinished.load (std::memory_order_acquire) == jobsLaunched.load (std::memory_order_relaxed))
+		jobPending = false;
+
+	return jobPending;
+}
+
+bool AudioWorker::launchJob() noexcept
+{
+	if (isBusy())
+		return false;
+
+	if (! isThreadRunning())
+	{
+		job();
+		return true;
+	}
+
+	jobPending = true;
+	jobsLaunched.fetch_add (1, std::memory_order_release);
+
+	return true;
+}
+
+bool AudioWorker::waitForJob (Deadline deadline) noexcept
+{
+	if (! jobPending)
+		return true;
+
+	// a bounded spin: the worker never signals, so there's no lock for the audio thread to wait on
+	while (jobsFinished.load (std::memory_order_acquire) != jobsLaunched.load (std::memory_order_relaxed))
+	{
+		if (std::chrono::steady_clock::now() >= deadline)
+			return false;
+
+		std::this_thread::yield();
+	}
+
+	jobPending = false;
+	return true;
+}
+
+/* Returns false if the thread should exit. */
+bool AudioWorker::waitForLaunch()
+{
+	const auto spinUntil = std::chrono::steady_clock::now() + std::chrono::milliseconds (spinAfterJobMs);
+
+	while (jobsLaunched.load (std::memory_order_acquire) == jobsFinished.load (std::memory_order_relaxed))
+	{
+		if (threadShouldExit())
+			return false;
+
+		if (std::chrono::steady_clock::now() < spinUntil)
+			std::this_thread::yield();
+		else
+			wait (1);
+	}
+
+	return true;
+}
+
+void AudioWorker::run()
+{
+	while (waitForLaunch())
+	{
+		{
+			IMOGEN_REALTIME_SCOPE;
+			job();
+		}
+
+		jobsFinished.fetch_add (1, std::memory_order_release);
+	}
+}
+
+}  // namespace Imogen
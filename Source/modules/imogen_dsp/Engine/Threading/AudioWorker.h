@@ -0,0 +1,57 @@
+#pragma once
+
+#include <imogen_dsp/Engine/Profiling/RealtimeChecker.h>
+
+namespace Imogen
+{
+/* A single helper thread that the audio thread can hand one job per block to.
+   The job is fixed at construction time, so launching it never allocates.
+   If the thread isn't running, launchJob() simply runs the job on the calling thread.
+   The handoff is lock-free: the audio thread only bumps an atomic count, and waits by spinning on the other one until a deadline.
+   The worker polls for jobs, spinning for a little while after each one so that it picks up the next block's job straight away,
+   and sleeping between polls once jobs stop arriving.
+   A job that overruns its wait keeps running, and everything it touches stays off-limits until isBusy() returns false.
+*/
+class AudioWorker : private juce::Thread
+{
+public:
+
+	using Job	   = std::function<void()>;
+	using Deadline = std::chrono::steady_clock::time_point;
+
+	AudioWorker (const juce::String& threadName, Job&& jobToRun);
+
+	~AudioWorker() override;
+
+	void start();
+	void stop();
+
+	bool isRunning() const;
+
+	/* True while a job that overran its wait is still running. */
+	bool isBusy() noexcept;
+
+	/* Returns false, without running the job, if the last one is still running. */
+	bool launchJob() noexcept;
+
+	/* Returns false if the job didn't finish before the deadline. */
+	bool waitForJob (Deadline deadline) noexcept;
+
+private:
+
+	void run() final;
+
+	bool waitForLaunch();
+
+	Job job;
+
+	// only touched by the audio thread
+	bool jobPending { false };
+
+	std::atomic<juce::uint32> jobsLaunched { 0 }, jobsFinished { 0 };
+
+	// how long the worker keeps spinning after a job before it starts sleeping between polls
+	static constexpr int spinAfterJobMs = 50;
+};
+
+}  // namespace Imogen
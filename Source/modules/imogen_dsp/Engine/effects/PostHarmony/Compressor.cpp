@@ -10,21 +10,35 @@ Compressor<SampleType>::Compressor (State& stateToUse)
 }
 
 template <typename SampleType>
-void Compressor<SampleType>::process (AudioBuffer& dry, AudioBuffer& wet)
+void Compressor<SampleType>::updateParameters()
 {
-	if (parameters.compToggle->get())
-	{
+	isOn = parameters.compToggle->get();
+
+	if (isOn)
 		updateCompressorAmount (parameters.compAmount->get());
+}
 
+template <typename SampleType>
+void Compressor<SampleType>::processDry (AudioBuffer& dry)
+{
+	if (isOn)
 		dryComp.process (dry);
+}
+
+template <typename SampleType>
+void Compressor<SampleType>::processWet (AudioBuffer& wet)
+{
+	if (isOn)
 		wetComp.process (wet);
+}
 
+template <typename SampleType>
+void Compressor<SampleType>::updateMeter()
+{
+	if (isOn)
 		meters.compRedux->set (static_cast<float> (dryComp.getAverageGainReduction() + wetComp.getAverageGainReduction()) * 0.5f);
-	}
 	else
-	{
 		meters.compRedux->set (0.f);
-	}
 }
 
 template <typename SampleType>
@@ -9,7 +9,12 @@ struct Compressor
 
 	Compressor (State& stateToUse);
 
-	void process (AudioBuffer& dry, AudioBuffer& wet);
+	void updateParameters();
+
+	void processDry (AudioBuffer& dry);
+	void processWet (AudioBuffer& wet);
+
+	void updateMeter();
 
 	void prepare (double samplerate, int blocksize);
 
@@ -22,6 +27,8 @@ private:
 	Meters&		meters { state.meters };
 
 	dsp::FX::Compressor<SampleType> dryComp, wetComp;
+
+	bool isOn { false };
 };
 
 }  // namespace Imogen
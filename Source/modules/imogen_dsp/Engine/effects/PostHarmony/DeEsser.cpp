@@ -7,28 +7,44 @@ DeEsser<SampleType>::DeEsser (State& stateToUse) : state (stateToUse)
 }
 
 template <typename SampleType>
-void DeEsser<SampleType>::process (AudioBuffer& dry, AudioBuffer& wet)
+void DeEsser<SampleType>::updateParameters()
 {
-	if (parameters.deEsserToggle->get())
-	{
-		const auto thresh = parameters.deEsserThresh->get();
-		const auto amount = parameters.deEsserAmount->get();
+	isOn = parameters.deEsserToggle->get();
 
-		dryDS.setThresh (thresh);
-		dryDS.setDeEssAmount (amount);
+	if (! isOn)
+		return;
 
-		wetDS.setThresh (thresh);
-		wetDS.setDeEssAmount (amount);
+	const auto thresh = parameters.deEsserThresh->get();
+	const auto amount = parameters.deEsserAmount->get();
 
+	dryDS.setThresh (thresh);
+	dryDS.setDeEssAmount (amount);
+
+	wetDS.setThresh (thresh);
+	wetDS.setDeEssAmount (amount);
+}
+
+template <typename SampleType>
+void DeEsser<SampleType>::processDry (AudioBuffer& dry)
+{
+	if (isOn)
 		dryDS.process (dry);
+}
+
+template <typename SampleType>
+void DeEsser<SampleType>::processWet (AudioBuffer& wet)
+{
+	if (isOn)
 		wetDS.process (wet);
+}
 
-		meters.compRedux->set (static_cast<float> (dryDS.getAverageGainReduction() + wetDS.getAverageGainReduction()) * 0.5f);
-	}
+template <typename SampleType>
+void DeEsser<SampleType>::updateMeter()
+{
+	if (isOn)
+		meters.deEssRedux->set (static_cast<float> (dryDS.getAverageGainReduction() + wetDS.getAverageGainReduction()) * 0.5f);
 	else
-	{
 		meters.deEssRedux->set (0.f);
-	}
 }
 
 template <typename SampleType>
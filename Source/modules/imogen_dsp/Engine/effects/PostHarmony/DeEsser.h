@@ -9,7 +9,12 @@ struct DeEsser
 
 	DeEsser (State& stateToUse);
 
-	void process (AudioBuffer& dry, AudioBuffer& wet);
+	void updateParameters();
+
+	void processDry (AudioBuffer& dry);
+	void processWet (AudioBuffer& wet);
+
+	void updateMeter();
 
 	void prepare (double samplerate, int blocksize);
 
@@ -20,6 +25,8 @@ private:
 	Meters&		meters { state.meters };
 
 	dsp::FX::DeEsser<SampleType> dryDS, wetDS;
+
+	bool isOn { false };
 };
 
 }  // namespace Imogen
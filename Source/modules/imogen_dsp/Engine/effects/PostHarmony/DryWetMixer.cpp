@@ -6,17 +6,55 @@ DryWetMixer<SampleType>::DryWetMixer (Parameters& params) : parameters (params)
 {
 }
 
+/* Writes the mix straight into the output buffer, so the dry and wet buffers are dead after this call. */
 template <typename SampleType>
-void DryWetMixer<SampleType>::process (AudioBuffer& dry, AudioBuffer& wet)
+void DryWetMixer<SampleType>::process (const AudioBuffer& dry, const AudioBuffer& wet, AudioBuffer& output)
 {
-	mixer.setWetMix (parameters.dryWet->get());
-	mixer.process (dry, wet);
+	wetGain.setTargetValue (static_cast<SampleType> (parameters.dryWet->get()) * SampleType (0.01));
+
+	const auto numSamples  = output.getNumSamples();
+	const auto numChannels = juce::jmin (output.getNumChannels(), dry.getNumChannels(), wet.getNumChannels());
+
+	for (int chan = numChannels; chan < output.getNumChannels(); ++chan)
+		output.clear (chan, 0, numSamples);
+
+	if (! wetGain.isSmoothing())
+	{
+		const auto wetMix = wetGain.getTargetValue();
+		const auto dryMix = SampleType (1) - wetMix;
+
+		for (int chan = 0; chan < numChannels; ++chan)
+		{
+			auto* out = output.getWritePointer (chan);
+
+			juce::FloatVectorOperations::copyWithMultiply (out, dry.getReadPointer (chan), dryMix, numSamples);
+			juce::FloatVectorOperations::addWithMultiply (out, wet.getReadPointer (chan), wetMix, numSamples);
+		}
+
+		return;
+	}
+
+	const auto* const* dryData = dry.getArrayOfReadPointers();
+	const auto* const* wetData = wet.getArrayOfReadPointers();
+	auto* const*	   outData = output.getArrayOfWritePointers();
+
+	for (int s = 0; s < numSamples; ++s)
+	{
+		const auto wetMix = wetGain.getNextValue();
+
+		for (int chan = 0; chan < numChannels; ++chan)
+		{
+			const auto drySample = dryData[chan][s];
+			outData[chan][s]	 = drySample + (wetData[chan][s] - drySample) * wetMix;
+		}
+	}
 }
 
 template <typename SampleType>
-void DryWetMixer<SampleType>::prepare (double samplerate, int blocksize)
+void DryWetMixer<SampleType>::prepare (double samplerate, int)
 {
-	mixer.prepare (2, blocksize, samplerate);
+	wetGain.reset (samplerate, 0.05);
+	wetGain.setCurrentAndTargetValue (static_cast<SampleType> (parameters.dryWet->get()) * SampleType (0.01));
 }
 
 template struct DryWetMixer<float>;
@@ -9,7 +9,7 @@ struct DryWetMixer
 
 	DryWetMixer (Parameters& params);
 
-	void process (AudioBuffer& dry, AudioBuffer& wet);
+	void process (const AudioBuffer& dry, const AudioBuffer& wet, AudioBuffer& output);
 
 	void prepare (double samplerate, int blocksize);
 
@@ -17,7 +17,7 @@ private:
 
 	Parameters& parameters;
 
-	dsp::FX::DryWetMixer<SampleType> mixer;
+	juce::SmoothedValue<SampleType> wetGain;
 };
 
 }  // namespace Imogen
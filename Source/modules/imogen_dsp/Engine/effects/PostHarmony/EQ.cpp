@@ -17,18 +17,31 @@ EQ<SampleType>::EQ (EQState& params)
 }
 
 template <typename SampleType>
-void EQ<SampleType>::process (AudioBuffer& dry, AudioBuffer& wet)
+void EQ<SampleType>::updateParameters()
 {
-	if (! parameters.eqToggle->get())
+	isOn = parameters.eqToggle->get();
+
+	if (! isOn)
 		return;
 
 	updateLowShelf (parameters.eqLowShelfFreq->get(), parameters.eqLowShelfQ->get(), parameters.eqLowShelfGain->get());
 	updateHighShelf (parameters.eqHighShelfFreq->get(), parameters.eqHighShelfQ->get(), parameters.eqHighShelfGain->get());
 	updatePeak (parameters.eqPeakFreq->get(), parameters.eqPeakQ->get(), parameters.eqPeakGain->get());
 	updateHighPass (parameters.eqHighPassFreq->get(), parameters.eqHighPassQ->get());
+}
+
+template <typename SampleType>
+void EQ<SampleType>::processDry (AudioBuffer& dry)
+{
+	if (isOn)
+		dryEQ.process (dry);
+}
 
-	dryEQ.process (dry);
-	wetEQ.process (wet);
+template <typename SampleType>
+void EQ<SampleType>::processWet (AudioBuffer& wet)
+{
+	if (isOn)
+		wetEQ.process (wet);
 }
 
 template <typename SampleType>
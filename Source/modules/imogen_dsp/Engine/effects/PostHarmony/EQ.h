@@ -10,7 +10,10 @@ struct EQ
 
 	EQ (EQState& params);
 
-	void process (AudioBuffer& dry, AudioBuffer& wet);
+	void updateParameters();
+
+	void processDry (AudioBuffer& dry);
+	void processWet (AudioBuffer& wet);
 
 	void prepare (double samplerate, int blocksize);
 
@@ -25,6 +28,8 @@ private:
 
 	EQState& parameters;
 
+	bool isOn { false };
+
 	dsp::FX::EQ<SampleType> dryEQ, wetEQ;
 };
 
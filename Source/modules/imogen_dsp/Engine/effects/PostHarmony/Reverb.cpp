@@ -7,9 +7,11 @@ Reverb<SampleType>::Reverb (State& stateToUse) : state (stateToUse)
 }
 
 template <typename SampleType>
-void Reverb<SampleType>::process (AudioBuffer& audio)
+void Reverb<SampleType>::process (AudioBuffer& audio, AudioBuffer& scratch)
 {
-	if (parameters.reverbToggle->get())
+	const auto isFading = allowedAmount.isSmoothing();
+
+	if (parameters.reverbToggle->get() && (isFading || allowedAmount.getTargetValue() > SampleType (0)))
 	{
 		reverb.setDryWet (parameters.reverbDryWet->get());
 		reverb.setDuckAmount (parameters.reverbDuck->get());
@@ -20,12 +22,26 @@ void Reverb<SampleType>::process (AudioBuffer& audio)
 		reverb.setDamping (1.f - d);
 		reverb.setRoomSize (d);
 
+		const auto numSamples = audio.getNumSamples();
+
+		if (isFading)
+		{
+			jassert (scratch.getNumChannels() >= audio.getNumChannels() && scratch.getNumSamples() >= numSamples);
+
+			for (int chan = 0; chan < audio.getNumChannels(); ++chan)
+				scratch.copyFrom (chan, 0, audio, chan, 0, numSamples);
+		}
+
 		SampleType level;
 		reverb.process (audio, &level);
 		meters.reverbLevel->set (static_cast<float> (level));
+
+		if (isFading)
+			crossfadeFromDry (audio, scratch);
 	}
 	else
 	{
+		allowedAmount.skip (audio.getNumSamples());
 		meters.reverbLevel->set (-60.f);
 	}
 }
@@ -34,6 +50,33 @@ template <typename SampleType>
 void Reverb<SampleType>::prepare (double samplerate, int blocksize)
 {
 	reverb.prepare (blocksize, samplerate, 2);
+	allowedAmount.reset (samplerate, 0.05);
+}
+
+template <typename SampleType>
+void Reverb<SampleType>::setAllowed (bool shouldBeAllowed) noexcept
+{
+	allowedAmount.setTargetValue (shouldBeAllowed ? SampleType (1) : SampleType (0));
+}
+
+template <typename SampleType>
+void Reverb<SampleType>::crossfadeFromDry (AudioBuffer& audio, const AudioBuffer& dry)
+{
+	const auto numSamples  = audio.getNumSamples();
+	const auto numChannels = audio.getNumChannels();
+
+	auto* const* wet = audio.getArrayOfWritePointers();
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const auto amount = allowedAmount.getNextValue();
+
+		for (int chan = 0; chan < numChannels; ++chan)
+		{
+			const auto drySample = dry.getSample (chan, i);
+			wet[chan][i]		 = drySample + amount * (wet[chan][i] - drySample);
+		}
+	}
 }
 
 template <typename SampleType>
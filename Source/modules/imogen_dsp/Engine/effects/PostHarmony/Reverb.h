@@ -9,19 +9,27 @@ struct Reverb
 
 	Reverb (State& stateToUse);
 
-	void process (AudioBuffer& audio);
+	/* The scratch buffer holds the dry signal while the reverb is fading in or out; its contents are overwritten. */
+	void process (AudioBuffer& audio, AudioBuffer& scratch);
 
 	void prepare (double samplerate, int blocksize);
 
 	void setWidth (float width);
 
+	/* When not allowed, the reverb fades out and is then bypassed until it's allowed again. */
+	void setAllowed (bool shouldBeAllowed) noexcept;
+
 private:
 
+	void crossfadeFromDry (AudioBuffer& audio, const AudioBuffer& dry);
+
 	State&		 state;
 	ReverbState& parameters { state.parameters.reverbState };
 	Meters&		 meters { state.meters };
 
 	dsp::FX::Reverb reverb;
+
+	juce::SmoothedValue<SampleType> allowedAmount { SampleType (1) };
 };
 
 }  // namespace Imogen
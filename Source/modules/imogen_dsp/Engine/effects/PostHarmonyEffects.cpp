@@ -18,23 +18,178 @@ void PostHarmonyEffects<SampleType>::prepare (double samplerate, int blocksize)
 	reverb.prepare (samplerate, blocksize);
 	outputGain.prepare (samplerate, blocksize);
 	limiter.prepare (samplerate, blocksize);
+
+	dryBranchBuffer.setSize (2, blocksize, true, true, true);
+	lastDryBlock.setSize (2, blocksize, true, true, true);
+
+	lastDryBlockSize	= 0;
+	reusingLastDryBlock = false;
+
+	if (internals.parallelPostHarmony->get())
+		dryBranchWorker.start();
+	else
+		dryBranchWorker.stop();
+}
+
+template <typename SampleType>
+void PostHarmonyEffects<SampleType>::process (AudioBuffer& harmonySignal, AudioBuffer& drySignal, AudioBuffer& output, AudioWorker::Deadline deadline)
+{
+	auto* mixedDry = &drySignal;
+
+	if (dryBranchWorker.isBusy())
+	{
+		// the last dry branch overran and still owns the dry effects
+		processWetBranch (harmonySignal);
+		mixedDry = &getReusedDryBlock (drySignal);
+	}
+	else if (! internals.parallelPostHarmony->get())
+	{
+		updateParameters();
+		processDryBranch (drySignal);
+		processWetBranch (harmonySignal);
+	}
+	else
+	{
+		updateParameters();
+
+		dryBranchAlias.setDataToReferTo (dryBranchBuffer.getArrayOfWritePointers(), drySignal.getNumChannels(), drySignal.getNumSamples());
+
+		for (int chan = 0; chan < drySignal.getNumChannels(); ++chan)
+			dryBranchAlias.copyFrom (chan, 0, drySignal, chan, 0, drySignal.getNumSamples());
+
+		dryBranchWorker.launchJob();
+
+		processWetBranch (harmonySignal);
+
+		if (dryBranchWorker.waitForJob (deadline))
+		{
+			keepProcessedDryBlock();
+			mixedDry = &dryBranchAlias;
+		}
+		else
+		{
+			mixedDry = &getReusedDryBlock (drySignal);
+		}
+	}
+
+	if (! dryBranchWorker.isBusy())
+	{
+		compressor.updateMeter();
+		deEsser.updateMeter();
+	}
+
+	{
+		IMOGEN_TIME_STAGE (state, dryWetMixer);
+		dryWetMixer.process (*mixedDry, harmonySignal, output);
+	}
+
+	{
+		IMOGEN_TIME_STAGE (state, delay);
+		delay.process (output);
+	}
+
+	{
+		IMOGEN_TIME_STAGE (state, reverb);
+		// the harmony signal is dead after the mix, so the reverb borrows it as scratch space
+		reverb.process (output, harmonySignal);
+	}
+
+	{
+		IMOGEN_TIME_STAGE (state, outputGain);
+		outputGain.process (output);
+	}
+
+	{
+		IMOGEN_TIME_STAGE (state, limiter);
+		limiter.process (output);
+	}
+}
+
+template <typename SampleType>
+typename PostHarmonyEffects<SampleType>::AudioBuffer& PostHarmonyEffects<SampleType>::getReusedDryBlock (AudioBuffer& drySignal)
+{
+	const auto numChannels = drySignal.getNumChannels();
+	const auto numSamples  = drySignal.getNumSamples();
+
+	// before the dry branch has finished a block this size, there's nothing to reuse
+	if (numSamples > lastDryBlockSize || numChannels > lastDryBlock.getNumChannels())
+		return drySignal;
+
+	reusingLastDryBlock = true;
+
+	lastDryAlias.setDataToReferTo (lastDryBlock.getArrayOfWritePointers(), numChannels, numSamples);
+	return lastDryAlias;
+}
+
+template <typename SampleType>
+void PostHarmonyEffects<SampleType>::keepProcessedDryBlock()
+{
+	const auto numChannels = juce::jmin (dryBranchAlias.getNumChannels(), lastDryBlock.getNumChannels());
+	const auto numSamples  = juce::jmin (dryBranchAlias.getNumSamples(), lastDryBlock.getNumSamples());
+
+	if (reusingLastDryBlock)
+	{
+		const auto fadeLength = juce::jmin (numSamples, lastDryBlockSize);
+
+		for (int chan = 0; chan < numChannels; ++chan)
+		{
+			dryBranchAlias.applyGainRamp (chan, 0, fadeLength, SampleType (0), SampleType (1));
+			dryBranchAlias.addFromWithRamp (chan, 0, lastDryBlock.getReadPointer (chan), fadeLength, SampleType (1), SampleType (0));
+		}
+
+		reusingLastDryBlock = false;
+	}
+
+	for (int chan = 0; chan < numChannels; ++chan)
+		lastDryBlock.copyFrom (chan, 0, dryBranchAlias, chan, 0, numSamples);
+
+	lastDryBlockSize = numSamples;
+}
+
+template <typename SampleType>
+void PostHarmonyEffects<SampleType>::updateParameters()
+{
+	eq.updateParameters();
+	compressor.updateParameters();
+	deEsser.updateParameters();
 }
 
 template <typename SampleType>
-void PostHarmonyEffects<SampleType>::process (AudioBuffer& harmonySignal, AudioBuffer& drySignal, AudioBuffer& output)
+void PostHarmonyEffects<SampleType>::processDryBranch (AudioBuffer& drySignal)
 {
-	eq.process (drySignal, harmonySignal);
-	compressor.process (drySignal, harmonySignal);
-	deEsser.process (drySignal, harmonySignal);
+	{
+		IMOGEN_TIME_STAGE (state, eq);
+		eq.processDry (drySignal);
+	}
+
+	{
+		IMOGEN_TIME_STAGE (state, compressor);
+		compressor.processDry (drySignal);
+	}
+
+	{
+		IMOGEN_TIME_STAGE (state, deEsser);
+		deEsser.processDry (drySignal);
+	}
+}
 
-	dryWetMixer.process (drySignal, harmonySignal);
+template <typename SampleType>
+void PostHarmonyEffects<SampleType>::processWetBranch (AudioBuffer& harmonySignal)
+{
+	{
+		IMOGEN_TIME_STAGE (state, eq);
+		eq.processWet (harmonySignal);
+	}
 
-	delay.process (harmonySignal);
-	reverb.process (harmonySignal);
-	outputGain.process (harmonySignal);
-	limiter.process (harmonySignal);
+	{
+		IMOGEN_TIME_STAGE (state, compressor);
+		compressor.processWet (harmonySignal);
+	}
 
-	dsp::buffers::copy (harmonySignal, output);
+	{
+		IMOGEN_TIME_STAGE (state, deEsser);
+		deEsser.processWet (harmonySignal);
+	}
 }
 
 template <typename SampleType>
@@ -43,6 +198,12 @@ void PostHarmonyEffects<SampleType>::updateStereoWidth (int width)
 	reverb.setWidth (static_cast<float> (width) * 0.01f);
 }
 
+template <typename SampleType>
+void PostHarmonyEffects<SampleType>::setReverbAllowed (bool shouldBeAllowed) noexcept
+{
+	reverb.setAllowed (shouldBeAllowed);
+}
+
 template class PostHarmonyEffects<float>;
 template class PostHarmonyEffects<double>;
 
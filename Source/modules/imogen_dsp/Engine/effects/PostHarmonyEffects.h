@@ -15,6 +15,8 @@
 #include "PostHarmony/OutputGain.h"
 #include "PostHarmony/Limiter.h"
 
+#include <imogen_dsp/Engine/Threading/AudioWorker.h>
+
 namespace Imogen
 {
 template <typename SampleType>
@@ -28,14 +30,26 @@ public:
 
 	void prepare (double samplerate, int blocksize);
 
-	void process (AudioBuffer& harmonySignal, AudioBuffer& drySignal, AudioBuffer& output);
+	/* In parallel mode the audio thread waits for the dry branch until the deadline at most. */
+	void process (AudioBuffer& harmonySignal, AudioBuffer& drySignal, AudioBuffer& output, AudioWorker::Deadline deadline);
 
 	void updateStereoWidth (int width);
 
+	void setReverbAllowed (bool shouldBeAllowed) noexcept;
+
 private:
 
+	void updateParameters();
+
+	void processDryBranch (AudioBuffer& drySignal);
+	void processWetBranch (AudioBuffer& harmonySignal);
+
+	AudioBuffer& getReusedDryBlock (AudioBuffer& drySignal);
+	void		 keepProcessedDryBlock();
+
 	State&		state;
 	Parameters& parameters { state.parameters };
+	Internals&	internals { state.internals };
 
 	EQ<SampleType>		   eq { parameters.eqState };
 	Compressor<SampleType> compressor { state };
@@ -46,6 +60,22 @@ private:
 	Reverb<SampleType>		reverb { state };
 	OutputGain<SampleType>	outputGain { parameters };
 	Limiter<SampleType>		limiter { state };
+
+	// in parallel mode the worker processes its own copy of the dry signal, so a job that overruns never races the lead processor
+	AudioBuffer dryBranchBuffer, dryBranchAlias;
+
+	// while the dry branch is late, the last block it processed is mixed again instead of the raw lead,
+	// so its effects don't cut out; the next block it processes is crossfaded in from it
+	AudioBuffer lastDryBlock, lastDryAlias;
+	int			lastDryBlockSize { 0 };
+	bool		reusingLastDryBlock { false };
+
+	AudioWorker dryBranchWorker { "Imogen dry branch", [this]
+								  {
+									  const ScopedTraceEvent traceEvent { state.trace, TraceRecorder::Category::worker,
+																		  static_cast<int> (TraceRecorder::Worker::dryBranch) };
+									  processDryBranch (dryBranchAlias);
+								  } };
 };
 
 }  // namespace Imogen
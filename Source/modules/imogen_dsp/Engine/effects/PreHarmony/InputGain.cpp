@@ -12,7 +12,13 @@ void InputGain<SampleType>::process (AudioBuffer& audio)
 	gain.setGain (parameters.inputGain->get());
 	gain.process (audio);
 
-	meters.inputLevel->set (static_cast<float> (audio.getRMSLevel (0, 0, audio.getNumSamples())));
+	level = static_cast<float> (audio.getRMSLevel (0, 0, audio.getNumSamples()));
+}
+
+template <typename SampleType>
+void InputGain<SampleType>::updateMeter()
+{
+	meters.inputLevel->set (level);
 }
 
 template <typename SampleType>
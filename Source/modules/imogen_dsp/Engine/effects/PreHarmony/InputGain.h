@@ -12,6 +12,8 @@ struct InputGain
 
 	void process (AudioBuffer& audio);
 
+	void updateMeter();
+
 	void prepare (double samplerate, int blocksize);
 
 private:
@@ -21,6 +23,8 @@ private:
 	Meters&		meters { state.meters };
 
 	dsp::FX::SmoothedGain<SampleType, 1> gain;
+
+	float level { 0.f };
 };
 
 }  // namespace Imogen
@@ -12,18 +12,22 @@ NoiseGate<SampleType>::NoiseGate (State& stateToUse) : state (stateToUse)
 template <typename SampleType>
 void NoiseGate<SampleType>::process (AudioBuffer& audio)
 {
-	if (parameters.noiseGateToggle->get())
-	{
-		gate.setThreshold (parameters.noiseGateThresh->get());
+	isOn = parameters.noiseGateToggle->get();
 
-		gate.process (audio);
+	if (! isOn)
+		return;
 
+	gate.setThreshold (parameters.noiseGateThresh->get());
+	gate.process (audio);
+}
+
+template <typename SampleType>
+void NoiseGate<SampleType>::updateMeter()
+{
+	if (isOn)
 		meters.gateRedux->set (static_cast<float> (gate.getAverageGainReduction()));
-	}
 	else
-	{
 		meters.gateRedux->set (0.f);
-	}
 }
 
 template <typename SampleType>
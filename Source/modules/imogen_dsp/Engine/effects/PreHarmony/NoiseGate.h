@@ -11,6 +11,8 @@ struct NoiseGate
 
 	void process (AudioBuffer& audio);
 
+	void updateMeter();
+
 	void prepare (double samplerate, int blocksize);
 
 private:
@@ -20,6 +22,8 @@ private:
 	Meters&		meters { state.meters };
 
 	dsp::FX::NoiseGate<SampleType> gate;
+
+	bool isOn { false };
 };
 
 }  // namespace Imogen
@@ -21,10 +21,32 @@ void PreHarmonyEffects<SampleType>::prepare (double samplerate, int blocksize)
 template <typename SampleType>
 void PreHarmonyEffects<SampleType>::process (const AudioBuffer& input)
 {
-	stereoReducer.process (input, processedMonoBuffer);
-	initialLoCut.process (processedMonoBuffer);
-	inputGain.process (processedMonoBuffer);
-	gate.process (processedMonoBuffer);
+	{
+		IMOGEN_TIME_STAGE (state, stereoReducer);
+		stereoReducer.process (input, processedMonoBuffer);
+	}
+
+	{
+		IMOGEN_TIME_STAGE (state, inputLoCut);
+		initialLoCut.process (processedMonoBuffer);
+	}
+
+	{
+		IMOGEN_TIME_STAGE (state, inputGain);
+		inputGain.process (processedMonoBuffer);
+	}
+
+	{
+		IMOGEN_TIME_STAGE (state, noiseGate);
+		gate.process (processedMonoBuffer);
+	}
+}
+
+template <typename SampleType>
+void PreHarmonyEffects<SampleType>::updateMeters()
+{
+	inputGain.updateMeter();
+	gate.updateMeter();
 }
 
 template <typename SampleType>
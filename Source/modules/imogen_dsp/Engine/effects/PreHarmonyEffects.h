@@ -1,5 +1,7 @@
 #pragma once
 
+#include <imogen_dsp/Engine/Profiling/StageTimer.h>
+
 namespace Imogen
 {
 template <typename SampleType>
@@ -15,6 +17,9 @@ public:
 
 	void process (const AudioBuffer& input);
 
+	/* Call from the audio thread, once the block has been processed. */
+	void updateMeters();
+
 	const SampleType* getProcessedInputSignal() const;
 
 private:
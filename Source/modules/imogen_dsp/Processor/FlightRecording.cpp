@@ -0,0 +1,272 @@
+
+namespace Imogen
+{
+bool FlightRecording::write (const FlightRecorder::Capture& capture, const juce::MemoryBlock& processorState,
+							 const juce::StringArray& parameterNames, const juce::File& folder)
+{
+	if (! folder.createDirectory())
+		return false;
+
+	{
+		const auto audioFile = folder.getChildFile ("input.wav");
+
+		auto stream = std::make_unique<juce::FileOutputStream> (audioFile);
+
+		if (! stream->openedOk())
+			return false;
+
+		juce::WavAudioFormat format;
+
+		// 32 bits, so the replayed input is bit-exact
+		std::unique_ptr<juce::AudioFormatWriter> writer (format.createWriterFor (stream.get(), capture.samplerate,
+																				 static_cast<unsigned int> (capture.audio.getNumChannels()),
+																				 32, {}, 0));
+
+		if (writer == nullptr)
+			return false;
+
+		stream.release();  // the writer now owns the stream
+
+		if (! writer->writeFromAudioSampleBuffer (capture.audio, 0, capture.audio.getNumSamples()))
+			return false;
+	}
+
+	if (! folder.getChildFile ("state.bin").replaceWithData (processorState.getData(), processorState.getSize()))
+		return false;
+
+	auto* root = new juce::DynamicObject();
+
+	root->setProperty ("samplerate", capture.samplerate);
+	root->setProperty ("blocksize", capture.blocksize);
+
+	juce::Array<juce::var> parameters;
+
+	for (int i = 0; i < capture.initialParameterValues.size(); ++i)
+	{
+		auto* param = new juce::DynamicObject();
+		param->setProperty ("index", capture.parameterIndices.getUnchecked (i));
+		param->setProperty ("name", parameterNames[capture.parameterIndices.getUnchecked (i)]);
+		param->setProperty ("initialValue", capture.initialParameterValues.getUnchecked (i));
+		parameters.add (param);
+	}
+
+	root->setProperty ("parameters", parameters);
+
+	juce::Array<juce::var> events;
+
+	for (const auto& event : capture.events)
+	{
+		auto* obj = new juce::DynamicObject();
+
+		obj->setProperty ("position", event.position);
+
+		if (event.parameterIndex >= 0)
+		{
+			obj->setProperty ("parameter", event.parameterIndex);
+			obj->setProperty ("value", event.newValue);
+		}
+		else
+		{
+			juce::Array<juce::var> bytes;
+
+			for (int i = 0; i < event.midiSize; ++i)
+				bytes.add (static_cast<int> (event.midiData[static_cast<size_t> (i)]));
+
+			obj->setProperty ("midi", bytes);
+		}
+
+		events.add (obj);
+	}
+
+	root->setProperty ("events", events);
+
+	juce::Array<juce::var> timings;
+
+	for (const auto& timing : capture.timings)
+		timings.add (juce::Array<juce::var> { timing.position, timing.numSamples, timing.load });
+
+	root->setProperty ("timings", timings);
+
+	return folder.getChildFile ("capture.json").replaceWithText (juce::JSON::toString (juce::var (root)));
+}
+
+bool FlightRecording::read (const juce::File& folder, FlightRecorder::Capture& capture, juce::MemoryBlock& processorState)
+{
+	{
+		auto stream = folder.getChildFile ("input.wav").createInputStream();
+
+		if (stream == nullptr)
+			return false;
+
+		juce::WavAudioFormat format;
+
+		std::unique_ptr<juce::AudioFormatReader> reader (format.createReaderFor (stream.release(), true));
+
+		if (reader == nullptr)
+			return false;
+
+		const auto numSamples = static_cast<int> (reader->lengthInSamples);
+
+		capture.audio.setSize (static_cast<int> (reader->numChannels), numSamples);
+
+		if (! reader->read (&capture.audio, 0, numSamples, 0, true, true))
+			return false;
+	}
+
+	processorState.reset();
+
+	if (! folder.getChildFile ("state.bin").loadFileAsData (processorState))
+		return false;
+
+	const auto json = juce::JSON::parse (folder.getChildFile ("capture.json"));
+
+	if (! json.isObject())
+		return false;
+
+	capture.samplerate = json["samplerate"];
+	capture.blocksize  = json["blocksize"];
+
+	capture.parameterIndices.clearQuick();
+	capture.initialParameterValues.clearQuick();
+
+	if (const auto* parameters = json["parameters"].getArray())
+	{
+		for (const auto& param : *parameters)
+		{
+			capture.parameterIndices.add (param["index"]);
+			capture.initialParameterValues.add (param["initialValue"]);
+		}
+	}
+
+	capture.events.clear();
+
+	if (const auto* events = json["events"].getArray())
+	{
+		for (const auto& obj : *events)
+		{
+			FlightRecorder::Event event;
+
+			event.position = static_cast<juce::int64> (obj["position"]);
+
+			if (const auto* bytes = obj["midi"].getArray())
+			{
+				event.midiSize = juce::jmin (3, bytes->size());
+
+				for (int i = 0; i < event.midiSize; ++i)
+					event.midiData[static_cast<size_t> (i)] = static_cast<juce::uint8> (static_cast<int> (bytes->getReference (i)));
+			}
+			else
+			{
+				event.parameterIndex = obj["parameter"];
+				event.newValue		 = obj["value"];
+				event.oldValue		 = event.newValue;
+			}
+
+			capture.events.push_back (event);
+		}
+	}
+
+	capture.timings.clear();
+
+	if (const auto* timings = json["timings"].getArray())
+		for (const auto& timing : *timings)
+			capture.timings.push_back ({ static_cast<juce::int64> (timing[0]), timing[1], timing[2] });
+
+	return capture.samplerate > 0. && capture.blocksize > 0;
+}
+
+juce::File FlightRecording::getNewCaptureFolder()
+{
+	return juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+		.getChildFile ("Imogen")
+		.getChildFile ("Flight recordings")
+		.getChildFile (juce::Time::getCurrentTime().formatted ("%Y-%m-%d %H-%M-%S"))
+		.getNonexistentSibling();
+}
+
+
+FlightRecordingDumper::Thread::Thread()
+	: juce::TimeSliceThread ("Imogen flight recorder")
+{
+	startThread();
+}
+
+FlightRecordingDumper::Thread::~Thread()
+{
+	stopThread (5000);
+}
+
+FlightRecordingDumper::FlightRecordingDumper (juce::AudioProcessor& processorToUse, FlightRecorder& recorderToUse)
+	: processor (processorToUse), recorder (recorderToUse)
+{
+	thread->addTimeSliceClient (this);
+}
+
+FlightRecordingDumper::~FlightRecordingDumper()
+{
+	thread->removeTimeSliceClient (this);
+}
+
+void FlightRecordingDumper::dumpNow() noexcept
+{
+	forceDump.store (true);
+}
+
+juce::File FlightRecordingDumper::getLastCaptureFolder() const
+{
+	const juce::ScopedLock sl (lock);
+	return lastCaptureFolder;
+}
+
+int FlightRecordingDumper::useTimeSlice()
+{
+	if (forceDump.exchange (false))
+	{
+		recorder.takeDumpRequest();
+		dump();
+		return 100;
+	}
+
+	if (! recorder.takeDumpRequest())
+		return 100;
+
+	const auto cooldownMs = static_cast<juce::uint32> (FlightRecorder::windowSeconds * 1000.);
+
+	// an overrun soon after the last dump is still inside the window, so it's captured by the next one
+	if (lastDumpTime != 0 && juce::Time::getMillisecondCounter() - lastDumpTime < cooldownMs)
+	{
+		recorder.requestDump();
+		return 100;
+	}
+
+	dump();
+	return 100;
+}
+
+void FlightRecordingDumper::dump()
+{
+	FlightRecorder::Capture capture;
+
+	if (! recorder.getCapture (capture))
+		return;
+
+	lastDumpTime = juce::Time::getMillisecondCounter();
+
+	juce::MemoryBlock state;
+	processor.getStateInformation (state);
+
+	juce::StringArray parameterNames;
+
+	for (auto* param : processor.getParameters())
+		parameterNames.add (param->getName (100));
+
+	const auto folder = FlightRecording::getNewCaptureFolder();
+
+	if (! FlightRecording::write (capture, state, parameterNames, folder))
+		return;
+
+	const juce::ScopedLock sl (lock);
+	lastCaptureFolder = folder;
+}
+
+}  // namespace Imogen
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+namespace Imogen
+{
+/* Reads and writes flight recorder captures. Each capture is a folder holding the input audio, the processor's state,
+   and a JSON file with the MIDI, parameter changes and block timings.
+*/
+struct FlightRecording
+{
+	static bool write (const FlightRecorder::Capture& capture, const juce::MemoryBlock& processorState,
+					   const juce::StringArray& parameterNames, const juce::File& folder);
+
+	static bool read (const juce::File& folder, FlightRecorder::Capture& capture, juce::MemoryBlock& processorState);
+
+	/* Returns a new, uniquely named folder inside the user's application data folder. */
+	static juce::File getNewCaptureFolder();
+};
+
+
+/* Writes the processor's flight recorder captures to disk whenever one is requested, from a background thread
+   that's shared between every Imogen instance in the process.
+   Automatic dumps (after an overrun) are spaced at least one window apart; dumpNow() always writes one.
+*/
+class FlightRecordingDumper : private juce::TimeSliceClient
+{
+public:
+
+	FlightRecordingDumper (juce::AudioProcessor& processorToUse, FlightRecorder& recorderToUse);
+
+	~FlightRecordingDumper() override;
+
+	void dumpNow() noexcept;
+
+	/* Returns the folder that the last capture was written to. */
+	juce::File getLastCaptureFolder() const;
+
+private:
+
+	int useTimeSlice() final;
+
+	void dump();
+
+	struct Thread : juce::TimeSliceThread
+	{
+		Thread();
+		~Thread() override;
+	};
+
+	juce::AudioProcessor& processor;
+	FlightRecorder&		  recorder;
+
+	juce::SharedResourcePointer<Thread> thread;
+
+	std::atomic<bool> forceDump { false };
+
+	juce::uint32 lastDumpTime { 0 };
+
+	juce::File lastCaptureFolder;
+
+	juce::CriticalSection lock;
+};
+
+}  // namespace Imogen
@@ -7,6 +7,87 @@ Processor::Processor()
 											.withInput (TRANS ("Sidechain"), juce::AudioChannelSet::mono(), false)
 											.withOutput (TRANS ("Output"), juce::AudioChannelSet::stereo(), true))
 {
+	juce::Array<juce::AudioProcessorParameter*> recordedParameters;
+
+	for (auto* param : getParameters())
+		if (isHostParameter (*param))
+			recordedParameters.add (param);
+
+	getState().flightRecorder.setParameters (recordedParameters);
+
+	startTimerHz (10);
+}
+
+StageTimings& Processor::getStageTimings() noexcept
+{
+	return getState().stageTimings;
+}
+
+TraceRecorder& Processor::getTrace() noexcept
+{
+	return getState().trace;
+}
+
+void Processor::traceParameterChange (plugin::Parameter& param)
+{
+	auto& trace = getTrace();
+
+	if (! trace.isEnabled() || ! isHostParameter (param))
+		return;
+
+	trace.record (TraceRecorder::EventType::instant, TraceRecorder::Category::parameter,
+				  param.getParameterIndex(), juce::roundToInt (param.getValue() * 1000.f));
+}
+
+bool Processor::isHostParameter (const juce::AudioProcessorParameter& param)
+{
+	return param.isAutomatable() && param.getCategory() == juce::AudioProcessorParameter::genericParameter;
+}
+
+void Processor::dumpFlightRecording() noexcept
+{
+	flightRecordingDumper.dumpNow();
+}
+
+juce::File Processor::getLastFlightRecording() const
+{
+	return flightRecordingDumper.getLastCaptureFolder();
+}
+
+/*
+	Some wrappers call this from the audio thread, so it only stores the flag. If the profile in use changes,
+	the engine is prepared again from the message thread, unless the host prepares it first, as VST3 hosts do.
+*/
+void Processor::setNonRealtime (bool isNonRealtime) noexcept
+{
+	plugin::Processor<State, Engine>::setNonRealtime (isNonRealtime);
+	getState().nonRealtime.store (isNonRealtime);
+}
+
+void Processor::setQualityProfile (QualityProfile newProfile)
+{
+	getState().qualityProfile.store (newProfile);
+}
+
+/*
+	Some settings are only read when the engine is prepared, because they change its latency or what it allocates.
+	Hosts only prepare when they choose to, so when one of them changes, the engine is prepared again from the message thread.
+*/
+void Processor::timerCallback()
+{
+	auto& state = getState();
+
+	if (getSampleRate() <= 0. || getBlockSize() <= 0 || state.preparedSettings.load() == state.getPrepareSettings())
+		return;
+
+	suspendProcessing (true);
+	prepareToPlay (getSampleRate(), getBlockSize());
+	suspendProcessing (false);
+}
+
+TuningTable& Processor::getTuning() noexcept
+{
+	return tuning;
 }
 
 double Processor::getTailLengthSeconds() const
@@ -2,15 +2,34 @@
 #pragma once
 
 #include <imogen_dsp/Engine/Engine.h>
+#include "FlightRecording.h"
 
 namespace Imogen
 {
 class Processor : public plugin::Processor<State, Engine>
+	, private juce::Timer
 {
 public:
 
 	Processor();
 
+	StageTimings&  getStageTimings() noexcept;
+	TraceRecorder& getTrace() noexcept;
+
+	/* Writes the flight recorder's window to disk, from a background thread. The recorder must be switched on in the Internals. */
+	void dumpFlightRecording() noexcept;
+
+	juce::File getLastFlightRecording() const;
+
+	/* A local scale, used whenever no MTS-ESP master is connected. It isn't saved with the processor's state,
+	   so it's only for tools like the offline renderer that load it again for every run; the plugin itself
+	   doesn't load local scales, and takes its microtuning from an MTS-ESP master. */
+	TuningTable& getTuning() noexcept;
+
+	/* By default the engine follows the host's offline flag; replays and benchmarks choose the realtime profile explicitly.
+	   Like the host's flag, this takes effect the next time the engine is prepared. */
+	void setQualityProfile (QualityProfile newProfile);
+
 private:
 
 	bool canAddBus (bool isInput) const override final { return isInput; }
@@ -18,6 +37,8 @@ private:
 
 	double getTailLengthSeconds() const final;
 
+	void setNonRealtime (bool isNonRealtime) noexcept override;
+
 	bool acceptsMidi() const final { return true; }
 	bool producesMidi() const final { return true; }
 	bool supportsMPE() const final { return false; }
@@ -26,7 +47,22 @@ private:
 	const String	  getName() const final { return "Imogen"; }
 	juce::StringArray getAlternateDisplayNames() const final { return { "Imgn" }; }
 
-	Parameters& parameters { getState().parameters };
+	void timerCallback() final;
+
+	void traceParameterChange (plugin::Parameter& param);
+
+	/* True for the parameters a host sees and automates; meters and internals aren't traced or recorded. */
+	static bool isHostParameter (const juce::AudioProcessorParameter& param);
+
+	Parameters&	 parameters { getState().parameters };
+	TuningTable& tuning { getState().tuning };
+
+	plugin::ParameterList::Listener parameterTracer { parameters,
+													  [&] (plugin::Parameter& param)
+													  { traceParameterChange (param); },
+													  [] (plugin::Parameter&, bool) {} };
+
+	FlightRecordingDumper flightRecordingDumper { *this, getState().flightRecorder };
 
 	// network::OscDataSynchronizer dataSync {state};
 };
@@ -1,6 +1,14 @@
 
 #include "imogen_dsp.h"
 
+#include "Engine/Profiling/RealtimeChecker.cpp"
+#include "Engine/Threading/AudioWorker.cpp"
+#include "Engine/Profiling/CpuLoadMeter.cpp"
+#include "Engine/Governor/QualityGovernor.cpp"
+#include "Engine/Midi/MidiOutputGenerator.cpp"
+#include "Engine/Analysis/VoicingDetector.cpp"
+#include "Engine/Analysis/SpectralEnvelope.cpp"
+#include "Engine/Resampling/InternalRateConverter.cpp"
 
 #include "Engine/effects/PreHarmony/StereoReducer.cpp"
 #include "Engine/effects/PreHarmony/InputGain.cpp"
@@ -8,7 +16,13 @@
 #include "Engine/effects/PreHarmonyEffects.cpp"
 
 #include "Engine/Harmonizer/Harmonizer.cpp"
+#include "Engine/Harmonizer/BlockEnvelope.cpp"
+#include "Engine/Harmonizer/Unison.cpp"
+#include "Engine/Harmonizer/FormantCorrector.cpp"
 #include "Engine/Harmonizer/HarmonizerVoice.cpp"
+#include "Engine/Harmonizer/VoiceTable.cpp"
+#include "Engine/Harmonizer/MtsEspTable.cpp"
+#include "Engine/Harmonizer/AutoHarmony/AutoHarmony.cpp"
 
 #include "Engine/Lead/LeadProcessor.cpp"
 #include "Engine/Lead/DryPanner.cpp"
@@ -27,4 +41,5 @@
 
 #include "Engine/Engine.cpp"
 
+#include "Processor/FlightRecording.cpp"
 #include "Processor/Processor.cpp"
@@ -10,10 +10,26 @@
  version:            0.0.1
  name:               imogen_dsp
  description:        DSP module for Imogen
- dependencies:       lemons_synth lemons_psola imogen_state
+ dependencies:       lemons_synth lemons_psola imogen_state juce_audio_formats
 
  END_JUCE_MODULE_DECLARATION
 
 -------------------------------------------------------------------------------------*/
 
+/** Config: IMOGEN_STAGE_TIMING
+	Enables scoped timers around each stage of the engine and each effect in the pre- and post-harmony chains.
+	The timings are recorded into the State's StageTimings, and each stage is marked in the State's trace while it's recording.
+*/
+#ifndef IMOGEN_STAGE_TIMING
+#	define IMOGEN_STAGE_TIMING 0
+#endif
+
+/** Config: IMOGEN_RT_CHECK
+	Reports every allocation, lock and sleep made on the audio thread while the engine renders, with the offending stack.
+	This replaces the global allocator, so it should only be enabled for dedicated checking builds.
+*/
+#ifndef IMOGEN_RT_CHECK
+#	define IMOGEN_RT_CHECK 0
+#endif
+
 #include "Processor/Processor.h"
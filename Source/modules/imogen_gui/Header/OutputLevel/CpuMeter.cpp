@@ -0,0 +1,57 @@
+
+namespace Imogen
+{
+CpuMeter::CpuMeter (Meters& metersToUse)
+	: meters (metersToUse)
+{
+	startTimerHz (10);
+}
+
+void CpuMeter::timerCallback()
+{
+	const auto newLoad	   = load.get();
+	const auto newPeak	   = peak.get();
+	const auto newOverruns = overruns.get();
+
+	if (newLoad == lastLoad && newPeak == lastPeak && newOverruns == lastOverruns)
+		return;
+
+	lastLoad	 = newLoad;
+	lastPeak	 = newPeak;
+	lastOverruns = newOverruns;
+
+	repaint();
+}
+
+void CpuMeter::paint (juce::Graphics& g)
+{
+	auto bounds = getLocalBounds().toFloat();
+
+	const auto barArea = bounds.removeFromTop (bounds.getHeight() * 0.4f).reduced (1.f);
+
+	const auto proportionOf = [&] (int percent)
+	{ return barArea.getWidth() * juce::jlimit (0.f, 1.f, static_cast<float> (percent) / 100.f); };
+
+	g.setColour (juce::Colours::darkgrey);
+	g.fillRect (barArea);
+
+	g.setColour (lastPeak >= 100 ? juce::Colours::red : lastLoad >= 70 ? juce::Colours::orange : juce::Colours::green);
+	g.fillRect (barArea.withWidth (proportionOf (lastLoad)));
+
+	g.setColour (juce::Colours::white);
+	g.drawVerticalLine (juce::roundToInt (barArea.getX() + proportionOf (lastPeak)), barArea.getY(), barArea.getBottom());
+
+	auto text = TRANS ("CPU") + " " + load.getCurrentValueAsText() + " (" + TRANS ("peak") + " " + peak.getCurrentValueAsText() + ")";
+
+	if (lastOverruns > 0)
+		text << ", " << lastOverruns << " " << TRANS ("overruns");
+
+	g.setFont (juce::jmin (12.f, bounds.getHeight()));
+	g.drawFittedText (text, bounds.toNearestInt(), juce::Justification::centredLeft, 1);
+}
+
+void CpuMeter::resized()
+{
+}
+
+}  // namespace Imogen
@@ -0,0 +1,29 @@
+#pragma once
+
+namespace Imogen
+{
+/* Shows this instance's CPU load, its held peak, and how many blocks have gone over the real-time budget. */
+class CpuMeter : public juce::Component
+	, private juce::Timer
+{
+public:
+
+	CpuMeter (Meters& metersToUse);
+
+private:
+
+	void paint (juce::Graphics& g) final;
+	void resized() final;
+
+	void timerCallback() final;
+
+	Meters& meters;
+
+	plugin::IntParameter& load { *meters.cpuLoad };
+	plugin::IntParameter& peak { *meters.cpuLoadPeak };
+	plugin::IntParameter& overruns { *meters.blockOverruns };
+
+	int lastLoad { -1 }, lastPeak { -1 }, lastOverruns { -1 };
+};
+
+}  // namespace Imogen
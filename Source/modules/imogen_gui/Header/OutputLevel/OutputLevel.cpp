@@ -4,7 +4,7 @@ namespace Imogen
 OutputLevel::OutputLevel (State& stateToUse)
 	: state (stateToUse)
 {
-	gui::addAndMakeVisible (this, thumb, meter);
+	gui::addAndMakeVisible (this, thumb, meter, cpuMeter);
 }
 
 void OutputLevel::paint (juce::Graphics&)
@@ -13,6 +13,10 @@ void OutputLevel::paint (juce::Graphics&)
 
 void OutputLevel::resized()
 {
+	auto bounds = getLocalBounds();
+
+	cpuMeter.setBounds (bounds.removeFromBottom (bounds.getHeight() / 4));
+
 	// thumb, meter
 }
 
@@ -2,6 +2,7 @@
 
 #include "LevelMeter.h"
 #include "Thumb.h"
+#include "CpuMeter.h"
 
 namespace Imogen
 {
@@ -20,6 +21,7 @@ private:
 
 	OutputLevelMeter meter { state.meters };
 	OutputLevelThumb thumb { state.parameters };
+	CpuMeter		 cpuMeter { state.meters };
 };
 
 }  // namespace Imogen
@@ -6,6 +6,7 @@
 #include "Header/ScaleChooser.cpp"
 #include "Header/OutputLevel/LevelMeter.cpp"
 #include "Header/OutputLevel/Thumb.cpp"
+#include "Header/OutputLevel/CpuMeter.cpp"
 #include "Header/OutputLevel/OutputLevel.cpp"
 #include "Header/InputIcon.cpp"
 #include "Header/AboutPopup/AboutPopup.cpp"
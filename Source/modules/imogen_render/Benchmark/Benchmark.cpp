@@ -0,0 +1,261 @@
+
+namespace Imogen
+{
+juce::String BenchmarkCase::getDescription() const
+{
+	juce::String effects = enabledEffects.isEmpty() ? "no effects" : enabledEffects.joinIntoString (", ");
+
+	return juce::String (blocksize) + " samples, " + juce::String (samplerate / 1000., 1) + " kHz, "
+		 + juce::String (numVoices) + " voices, " + effects;
+}
+
+void BenchmarkResult::printStageBreakdown (std::ostream& stream) const
+{
+	const auto total = stageNanosPerSample[0];
+
+	if (total <= 0.)
+		return;
+
+	for (int i = 1; i < StageTimings::numStages; ++i)
+	{
+		const auto nanos = stageNanosPerSample[static_cast<size_t> (i)];
+
+		if (nanos <= 0.)
+			continue;
+
+		stream << "    " << StageTimings::getStageName (static_cast<StageTimings::Stage> (i)).paddedRight (' ', 22)
+			   << juce::String (nanos, 2) << " ns/sample (" << juce::String (nanos / total * 100., 1) << "%), p99 "
+			   << juce::String (static_cast<double> (stageP99Nanos[static_cast<size_t> (i)]) / 1000., 1) << " us" << std::endl;
+	}
+}
+
+Benchmark::Benchmark (bool useDoublePrecision, double secondsOfAudioPerCase)
+	: doublePrecision (useDoublePrecision), secondsPerCase (secondsOfAudioPerCase)
+{
+}
+
+const juce::StringArray& Benchmark::getEffectToggleNames()
+{
+	static const juce::StringArray names { "Gate toggle", "EQ toggle", "Compressor toggle", "D-S toggle",
+										   "Delay toggle", "Reverb toggle", "Limiter toggle" };
+
+	return names;
+}
+
+juce::Array<BenchmarkCase> Benchmark::getDefaultSweep()
+{
+	const BenchmarkCase baseline { 512, 48000., 4, getEffectToggleNames() };
+
+	juce::Array<BenchmarkCase> cases;
+
+	for (auto blocksize = 16; blocksize <= 4096; blocksize *= 2)
+	{
+		auto c		= baseline;
+		c.blocksize = blocksize;
+		cases.add (c);
+	}
+
+	for (const auto samplerate : { 44100., 88200., 96000., 176400., 192000. })
+	{
+		auto c		 = baseline;
+		c.samplerate = samplerate;
+		cases.add (c);
+	}
+
+	for (const auto numVoices : { 0, 1, 2, 8, 12, Harmonizer<float>::numVoices })
+	{
+		auto c		= baseline;
+		c.numVoices = numVoices;
+		cases.add (c);
+	}
+
+	// each effect on its own, so its cost can be read off against the 'no effects' case
+	auto noEffects = baseline;
+	noEffects.enabledEffects.clear();
+	cases.add (noEffects);
+
+	for (const auto& effect : getEffectToggleNames())
+	{
+		auto c			 = noEffects;
+		c.enabledEffects = juce::StringArray { effect };
+		cases.add (c);
+	}
+
+	return cases;
+}
+
+juce::Array<BenchmarkCase> Benchmark::getFullMatrix()
+{
+	juce::Array<BenchmarkCase> cases;
+
+	for (auto blocksize = 16; blocksize <= 4096; blocksize *= 2)
+		for (const auto samplerate : { 44100., 48000., 88200., 96000., 176400., 192000. })
+			for (const auto numVoices : { 0, 1, 2, 4, 8, 12, Harmonizer<float>::numVoices })
+				cases.add ({ blocksize, samplerate, numVoices, getEffectToggleNames() });
+
+	return cases;
+}
+
+const juce::AudioBuffer<float>& Benchmark::getInput (double samplerate)
+{
+	const auto key = juce::roundToInt (samplerate);
+
+	auto& buffer = inputCache[key];
+
+	if (buffer.getNumSamples() == 0)
+	{
+		buffer.setSize (2, juce::roundToInt (samplerate * (secondsPerCase + 1.)));
+		TestSignals::generateVocal (buffer, samplerate);
+	}
+
+	return buffer;
+}
+
+void Benchmark::setEffects (juce::AudioProcessor& processor, const juce::StringArray& enabledEffects)
+{
+	const auto& toggles = getEffectToggleNames();
+
+	for (auto* param : processor.getParameters())
+	{
+		const auto name = param->getName (100);
+
+		if (toggles.contains (name))
+			param->setValueNotifyingHost (enabledEffects.contains (name) ? 1.f : 0.f);
+	}
+}
+
+void Benchmark::setParameter (juce::AudioProcessor& processor, const juce::String& name, bool value)
+{
+	for (auto* param : processor.getParameters())
+		if (param->getName (100) == name)
+			param->setValueNotifyingHost (value ? 1.f : 0.f);
+}
+
+BenchmarkResult Benchmark::run (const BenchmarkCase& benchmarkCase)
+{
+	Processor	processor;
+	auto&		proc = static_cast<juce::AudioProcessor&> (processor);
+
+	// the live rendering path is what's being measured, at a fixed quality, so the governor mustn't step in
+	processor.setQualityProfile (QualityProfile::realtime);
+	setParameter (proc, "CPU quality governor", false);
+
+	jassert (benchmarkCase.numVoices <= Harmonizer<float>::numVoices);
+
+	setEffects (proc, benchmarkCase.enabledEffects);
+
+	const auto& input = getInput (benchmarkCase.samplerate);
+
+	const auto useDouble = doublePrecision && proc.supportsDoublePrecisionProcessing();
+
+	proc.setProcessingPrecision (useDouble ? juce::AudioProcessor::doublePrecision : juce::AudioProcessor::singlePrecision);
+
+	proc.prepareToPlay (benchmarkCase.samplerate, benchmarkCase.blocksize);
+
+	auto& timings = processor.getStageTimings();
+
+	const auto seconds = useDouble ? timeBlocks<double> (proc, timings, benchmarkCase, input)
+								   : timeBlocks<float> (proc, timings, benchmarkCase, input);
+
+	proc.releaseResources();
+
+	const auto numTimedSamples = secondsPerCase * benchmarkCase.samplerate;
+
+	BenchmarkResult result;
+
+	result.benchmarkCase  = benchmarkCase;
+	result.nanosPerSample = seconds * 1.0e9 / numTimedSamples;
+	result.realtimeFactor = seconds > 0. ? secondsPerCase / seconds : 0.;
+
+	for (int i = 0; i < StageTimings::numStages; ++i)
+	{
+		const auto& histogram = timings[static_cast<StageTimings::Stage> (i)];
+		const auto	index	  = static_cast<size_t> (i);
+
+		result.stageNanosPerSample[index] = static_cast<double> (histogram.getTotalNanos()) / numTimedSamples;
+		result.stageP99Nanos[index]		  = histogram.getPercentileNanos (0.99);
+	}
+
+	return result;
+}
+
+template <typename SampleType>
+double Benchmark::timeBlocks (juce::AudioProcessor& processor, StageTimings& timings, const BenchmarkCase& benchmarkCase, const juce::AudioBuffer<float>& input)
+{
+	const auto blocksize	= benchmarkCase.blocksize;
+	const auto numChannels	= juce::jmax (processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+	const auto warmupLength = juce::roundToInt (benchmarkCase.samplerate * 0.5);
+	const auto totalLength	= warmupLength + juce::roundToInt (benchmarkCase.samplerate * secondsPerCase);
+
+	juce::AudioBuffer<SampleType> block (numChannels, blocksize);
+	juce::MidiBuffer			  midi;
+
+	midi.ensureSize (1024);
+
+	const auto chord = TestSignals::getChordNotes (benchmarkCase.numVoices);
+
+	juce::int64 ticks = 0;
+
+	for (int pos = 0; pos < totalLength; pos += blocksize)
+	{
+		const auto numSamples = juce::jmin (blocksize, totalLength - pos);
+
+		block.setSize (numChannels, numSamples, false, false, true);
+
+		for (int chan = 0; chan < numChannels; ++chan)
+		{
+			const auto* in	= input.getReadPointer (juce::jmin (chan, input.getNumChannels() - 1), pos);
+			auto*		out = block.getWritePointer (chan);
+
+			for (int s = 0; s < numSamples; ++s)
+				out[s] = static_cast<SampleType> (in[s]);
+		}
+
+		midi.clear();
+
+		// the stage timers should only see the same blocks as the overall timer
+		if (pos >= warmupLength && pos - blocksize < warmupLength)
+			timings.reset();
+
+		if (pos == 0)
+			TestSignals::addChord (midi, chord);
+
+		const auto start = juce::Time::getHighResolutionTicks();
+
+		processor.processBlock (block, midi);
+
+		if (pos >= warmupLength)
+			ticks += juce::Time::getHighResolutionTicks() - start;
+	}
+
+	return juce::Time::highResolutionTicksToSeconds (ticks);
+}
+
+void Benchmark::printHeader (juce::OutputStream& stream)
+{
+	stream << "blocksize,samplerate,voices,effects,ns_per_sample,realtime_factor";
+
+#if IMOGEN_STAGE_TIMING
+	for (int i = 1; i < StageTimings::numStages; ++i)
+		stream << ',' << StageTimings::getStageName (static_cast<StageTimings::Stage> (i)).toLowerCase().replaceCharacter (' ', '_') << "_ns_per_sample";
+#endif
+
+	stream << juce::newLine;
+}
+
+void Benchmark::printResult (juce::OutputStream& stream, const BenchmarkResult& result)
+{
+	const auto& c = result.benchmarkCase;
+
+	stream << c.blocksize << ',' << c.samplerate << ',' << c.numVoices << ",\"" << c.enabledEffects.joinIntoString (";") << "\","
+		   << juce::String (result.nanosPerSample, 2) << ',' << juce::String (result.realtimeFactor, 2);
+
+#if IMOGEN_STAGE_TIMING
+	for (int i = 1; i < StageTimings::numStages; ++i)
+		stream << ',' << juce::String (result.stageNanosPerSample[static_cast<size_t> (i)], 2);
+#endif
+
+	stream << juce::newLine;
+}
+
+}  // namespace Imogen
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "TestSignals.h"
+
+namespace Imogen
+{
+struct BenchmarkCase
+{
+	int	   blocksize { 512 };
+	double samplerate { 48000. };
+	int	   numVoices { 4 };	 // at most the harmonizer's voice pool
+
+	/* Names of the effect toggle parameters to switch on; every other effect toggle is switched off. */
+	juce::StringArray enabledEffects;
+
+	juce::String getDescription() const;
+};
+
+struct BenchmarkResult
+{
+	BenchmarkCase benchmarkCase;
+
+	double nanosPerSample { 0. };
+	double realtimeFactor { 0. };
+
+	/* Only filled in when the engine is built with IMOGEN_STAGE_TIMING enabled. */
+	std::array<double, StageTimings::numStages>		  stageNanosPerSample {};
+	std::array<juce::uint64, StageTimings::numStages> stageP99Nanos {};
+
+	void printStageBreakdown (std::ostream& stream) const;
+};
+
+
+/* Drives a headless Imogen Processor with deterministic vocal-like input and a held MIDI chord,
+   and measures how long Engine::renderChunk takes, in either precision.
+*/
+class Benchmark
+{
+public:
+
+	Benchmark (bool useDoublePrecision, double secondsOfAudioPerCase);
+
+	BenchmarkResult run (const BenchmarkCase& benchmarkCase);
+
+	/* Sweeps one dimension at a time around a baseline case: blocksize, samplerate, voice count, and the effects one by one. */
+	static juce::Array<BenchmarkCase> getDefaultSweep();
+
+	/* The full cross product of the blocksizes, samplerates and voice counts, with all effects on. */
+	static juce::Array<BenchmarkCase> getFullMatrix();
+
+	static const juce::StringArray& getEffectToggleNames();
+
+	static void printHeader (juce::OutputStream& stream);
+	static void printResult (juce::OutputStream& stream, const BenchmarkResult& result);
+
+private:
+
+	template <typename SampleType>
+	double timeBlocks (juce::AudioProcessor& processor, StageTimings& timings, const BenchmarkCase& benchmarkCase, const juce::AudioBuffer<float>& input);
+
+	static void setEffects (juce::AudioProcessor& processor, const juce::StringArray& enabledEffects);
+	static void setParameter (juce::AudioProcessor& processor, const juce::String& name, bool value);
+
+	const juce::AudioBuffer<float>& getInput (double samplerate);
+
+	bool   doublePrecision;
+	double secondsPerCase;
+
+	std::map<int, juce::AudioBuffer<float>> inputCache;
+};
+
+}  // namespace Imogen
@@ -0,0 +1,87 @@
+
+namespace Imogen::TestSignals
+{
+void generateVocal (juce::AudioBuffer<float>& buffer, double samplerate, juce::int64 seed)
+{
+	static constexpr std::array<int, 8> melody { 57, 60, 64, 62, 59, 60, 55, 57 };
+
+	static constexpr auto noteSeconds	= 0.9;
+	static constexpr auto phraseSeconds = melody.size() * noteSeconds;
+	static constexpr auto burstSeconds	= 0.15;
+
+	juce::Random random (seed);
+
+	std::array<juce::IIRFilter, 3> formants;
+
+	formants[0].setCoefficients (juce::IIRCoefficients::makeBandPass (samplerate, 700., 4.));
+	formants[1].setCoefficients (juce::IIRCoefficients::makeBandPass (samplerate, 1220., 6.));
+	formants[2].setCoefficients (juce::IIRCoefficients::makeBandPass (samplerate, 2600., 8.));
+
+	const auto numSamples = buffer.getNumSamples();
+	auto*	   out		  = buffer.getWritePointer (0);
+
+	auto phase = 0.;
+
+	for (int s = 0; s < numSamples; ++s)
+	{
+		const auto time			= static_cast<double> (s) / samplerate;
+		const auto timeInPhrase = std::fmod (time, phraseSeconds + burstSeconds);
+
+		if (timeInPhrase >= phraseSeconds)
+		{
+			// unvoiced segment: a noise burst, like a sibilant
+			out[s] = (random.nextFloat() * 2.f - 1.f) * 0.1f;
+			continue;
+		}
+
+		const auto note	   = melody[static_cast<size_t> (timeInPhrase / noteSeconds)];
+		const auto vibrato = 0.3 * std::sin (juce::MathConstants<double>::twoPi * 5.5 * time);
+		const auto freq	   = juce::MidiMessage::getMidiNoteInHertz (note) * std::pow (2., vibrato / 12.);
+
+		phase += freq / samplerate;
+		phase -= std::floor (phase);
+
+		// band-limited sawtooth as the glottal source
+		auto source = 0.;
+
+		for (int harmonic = 1; harmonic * freq < samplerate * 0.45 && harmonic <= 40; ++harmonic)
+			source += std::sin (juce::MathConstants<double>::twoPi * phase * harmonic) / harmonic;
+
+		const auto noteTime = std::fmod (timeInPhrase, noteSeconds);
+		const auto envelope = juce::jmin (1., noteTime * 20., (noteSeconds - noteTime) * 20.);
+
+		const auto sample = static_cast<float> (source * envelope * 0.3);
+
+		out[s] = formants[0].processSingleSampleRaw (sample)
+			   + formants[1].processSingleSampleRaw (sample) * 0.7f
+			   + formants[2].processSingleSampleRaw (sample) * 0.4f;
+	}
+
+	for (int chan = 1; chan < buffer.getNumChannels(); ++chan)
+		buffer.copyFrom (chan, 0, buffer, 0, 0, numSamples);
+}
+
+juce::Array<int> getChordNotes (int numVoices, int rootNote)
+{
+	juce::Array<int> notes;
+
+	for (int i = 0; i < numVoices; ++i)
+	{
+		const auto note = rootNote + (i / 2) * 7 + (i % 2) * 4;
+
+		if (note > 127)
+			break;
+
+		notes.addIfNotAlreadyThere (note);
+	}
+
+	return notes;
+}
+
+void addChord (juce::MidiBuffer& midi, const juce::Array<int>& notes, int samplePosition, float velocity)
+{
+	for (const auto note : notes)
+		midi.addEvent (juce::MidiMessage::noteOn (1, note, velocity), samplePosition);
+}
+
+}  // namespace Imogen::TestSignals
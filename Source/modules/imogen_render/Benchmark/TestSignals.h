@@ -0,0 +1,16 @@
+#pragma once
+
+namespace Imogen::TestSignals
+{
+/* Fills the buffer with a deterministic, vocal-like test signal: a sung melody with vibrato,
+   shaped by three formant resonances, with short unvoiced noise bursts between phrases.
+*/
+void generateVocal (juce::AudioBuffer<float>& buffer, double samplerate, juce::int64 seed = 0x1e8d);
+
+/* Returns a chord of numVoices distinct notes, stacked in thirds upwards from the given root. */
+juce::Array<int> getChordNotes (int numVoices, int rootNote = 48);
+
+/* Adds note-ons for every note in the chord at the given sample position. */
+void addChord (juce::MidiBuffer& midi, const juce::Array<int>& notes, int samplePosition = 0, float velocity = 0.8f);
+
+}  // namespace Imogen::TestSignals
@@ -0,0 +1,387 @@
+
+namespace Imogen
+{
+OfflineRenderer::OfflineRenderer (const RenderSettings& settingsToUse)
+	: settings (settingsToUse)
+{
+	auto& proc = getProcessor();
+
+	proc.setNonRealtime (true);
+
+	if (settings.preset.existsAsFile())
+	{
+		juce::MemoryBlock data;
+
+		if (settings.preset.loadFileAsData (data))
+			proc.setStateInformation (data.getData(), static_cast<int> (data.getSize()));
+	}
+
+	// a scale that can't be loaded would otherwise quietly render in 12-TET
+	if (settings.scale != juce::File())
+	{
+		if (! processor.getTuning().loadFiles (settings.scale, settings.keyboardMapping))
+			setupError = TRANS ("Could not load scale ") + settings.scale.getFullPathName()
+					   + (settings.keyboardMapping != juce::File() ? TRANS (" with keyboard mapping ") + settings.keyboardMapping.getFullPathName() : juce::String());
+	}
+	else if (settings.keyboardMapping != juce::File())
+	{
+		setupError = TRANS ("A keyboard mapping needs a scale to go with it");
+	}
+}
+
+juce::String OfflineRenderer::render (const RenderJob& job)
+{
+	if (setupError.isNotEmpty())
+		return setupError;
+
+	juce::AudioBuffer<float> input;
+	double					 samplerate = 0.;
+
+	if (! loadAudio (job.audioInput, input, samplerate))
+		return TRANS ("Could not read audio file ") + job.audioInput.getFullPathName();
+
+	juce::MidiMessageSequence midi;
+
+	if (job.midiInput != juce::File() && ! loadMidi (job.midiInput, midi))
+		return TRANS ("Could not read MIDI file ") + job.midiInput.getFullPathName();
+
+	juce::AudioBuffer<float> output;
+
+	auto& trace = processor.getTrace();
+
+	// an offline render can run for a long time, so this keeps the last million events or so
+	if (settings.writeTrace)
+		trace.enable (1 << 20);
+
+	render (input, midi, samplerate, output);
+
+	trace.disable();
+
+	if (! writeAudio (job.output, output, samplerate, settings.outputBitDepth))
+		return TRANS ("Could not write audio file ") + job.output.getFullPathName();
+
+	if (settings.writeTrace)
+	{
+		const auto traceFile = job.output.withFileExtension ("trace.json");
+
+		if (! writeTrace (traceFile))
+			return TRANS ("Could not write trace file ") + traceFile.getFullPathName();
+	}
+
+	return {};
+}
+
+juce::String OfflineRenderer::replay (const juce::File& captureFolder, const juce::File& output)
+{
+	FlightRecorder::Capture capture;
+	juce::MemoryBlock		processorState;
+
+	if (! FlightRecording::read (captureFolder, capture, processorState))
+		return TRANS ("Could not read flight recording ") + captureFolder.getFullPathName();
+
+	auto& proc = getProcessor();
+
+	proc.setStateInformation (processorState.getData(), static_cast<int> (processorState.getSize()));
+
+	// the capture came from the audio thread, so it's replayed with the profile it was recorded with, not the offline one
+	processor.setQualityProfile (QualityProfile::realtime);
+
+	const auto& parameters = proc.getParameters();
+
+	// only the host-automatable parameters were recorded; meters and internals keep whatever the state set them to
+	for (int i = 0; i < juce::jmin (capture.parameterIndices.size(), capture.initialParameterValues.size()); ++i)
+		if (auto* param = parameters[capture.parameterIndices.getUnchecked (i)])
+			param->setValueNotifyingHost (capture.initialParameterValues.getUnchecked (i));
+
+	// the replay itself mustn't record, or dump a capture when it runs slower than real time
+	for (auto* param : parameters)
+		if (param->getName (100) == "Flight recorder")
+			param->setValueNotifyingHost (0.f);
+
+	juce::MidiMessageSequence midi;
+
+	for (const auto& event : capture.events)
+		if (event.parameterIndex < 0)
+			midi.addEvent (juce::MidiMessage (event.midiData.data(), event.midiSize, static_cast<double> (event.position) / capture.samplerate));
+
+	midi.sort();
+
+	juce::AudioBuffer<float> rendered;
+
+	{
+		const juce::ScopedValueSetter<int> blocksize (settings.blocksize, capture.blocksize);
+		const juce::ScopedValueSetter<const std::vector<FlightRecorder::Event>*> events (automation, &capture.events);
+
+		nextAutomationEvent = 0;
+
+		render (capture.audio, midi, capture.samplerate, rendered);
+	}
+
+	processor.setQualityProfile (QualityProfile::followHost);
+
+	if (! writeAudio (output, rendered, capture.samplerate, settings.outputBitDepth))
+		return TRANS ("Could not write audio file ") + output.getFullPathName();
+
+	return {};
+}
+
+void OfflineRenderer::applyAutomation (int startSample, int numSamples)
+{
+	if (automation == nullptr)
+		return;
+
+	const auto& parameters = getProcessor().getParameters();
+
+	const auto end = static_cast<juce::int64> (startSample + numSamples);
+
+	for (; nextAutomationEvent < automation->size(); ++nextAutomationEvent)
+	{
+		const auto& event = (*automation)[nextAutomationEvent];
+
+		if (event.position >= end)
+			break;
+
+		if (auto* param = parameters[event.parameterIndex])
+			param->setValueNotifyingHost (event.newValue);
+	}
+}
+
+void OfflineRenderer::render (const juce::AudioBuffer<float>& input, const juce::MidiMessageSequence& midi,
+							  double samplerate, juce::AudioBuffer<float>& output)
+{
+	auto& proc = getProcessor();
+
+	proc.releaseResources();
+
+	if (settings.doublePrecision && proc.supportsDoublePrecisionProcessing())
+	{
+		proc.setProcessingPrecision (juce::AudioProcessor::doublePrecision);
+		renderBlocks<double> (input, midi, samplerate, output);
+	}
+	else
+	{
+		proc.setProcessingPrecision (juce::AudioProcessor::singlePrecision);
+		renderBlocks<float> (input, midi, samplerate, output);
+	}
+
+	proc.releaseResources();
+}
+
+template <typename SampleType>
+void OfflineRenderer::renderBlocks (const juce::AudioBuffer<float>& input, const juce::MidiMessageSequence& midi,
+									double samplerate, juce::AudioBuffer<float>& output)
+{
+	auto& proc = getProcessor();
+
+	const auto blocksize = settings.blocksize;
+
+	proc.prepareToPlay (samplerate, blocksize);
+
+	const auto latency		   = proc.getLatencySamples();
+	const auto numInputSamples = input.getNumSamples();
+	const auto numOutputSamples = numInputSamples + juce::roundToInt (proc.getTailLengthSeconds() * samplerate);
+	const auto totalSamples	   = numOutputSamples + latency;
+	const auto numChannels	   = juce::jmax (proc.getTotalNumInputChannels(), proc.getTotalNumOutputChannels());
+
+	output.setSize (2, numOutputSamples);
+	output.clear();
+
+	juce::AudioBuffer<SampleType> block (numChannels, blocksize);
+	juce::MidiBuffer			  midiBuffer;
+
+	midiBuffer.ensureSize (4096);
+
+	int midiIndex = 0;
+
+	for (int pos = 0; pos < totalSamples; pos += blocksize)
+	{
+		const auto numSamples = juce::jmin (blocksize, totalSamples - pos);
+
+		block.setSize (numChannels, numSamples, false, false, true);
+		block.clear();
+
+		if (const auto numToCopy = juce::jlimit (0, numSamples, numInputSamples - pos); numToCopy > 0)
+		{
+			for (int chan = 0; chan < juce::jmin (2, numChannels); ++chan)
+			{
+				const auto* in	= input.getReadPointer (juce::jmin (chan, input.getNumChannels() - 1), pos);
+				auto*		out = block.getWritePointer (chan);
+
+				for (int s = 0; s < numToCopy; ++s)
+					out[s] = static_cast<SampleType> (in[s]);
+			}
+		}
+
+		midiBuffer.clear();
+
+		const auto blockEndTime = static_cast<double> (pos + numSamples) / samplerate;
+
+		for (; midiIndex < midi.getNumEvents(); ++midiIndex)
+		{
+			const auto& message = midi.getEventPointer (midiIndex)->message;
+
+			if (message.getTimeStamp() >= blockEndTime)
+				break;
+
+			midiBuffer.addEvent (message, juce::jlimit (0, numSamples - 1, juce::roundToInt (message.getTimeStamp() * samplerate) - pos));
+		}
+
+		applyAutomation (pos, numSamples);
+
+		proc.processBlock (block, midiBuffer);
+
+		// drop the first 'latency' samples, so that the output lines up with the input
+		for (int s = 0; s < numSamples; ++s)
+		{
+			const auto outputIndex = pos + s - latency;
+
+			if (outputIndex < 0 || outputIndex >= numOutputSamples)
+				continue;
+
+			for (int chan = 0; chan < 2; ++chan)
+				output.setSample (chan, outputIndex, static_cast<float> (block.getSample (juce::jmin (chan, numChannels - 1), s)));
+		}
+	}
+}
+
+bool OfflineRenderer::loadAudio (const juce::File& file, juce::AudioBuffer<float>& audio, double& samplerate)
+{
+	juce::AudioFormatManager formatManager;
+	formatManager.registerBasicFormats();
+
+	std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (file));
+
+	if (reader == nullptr)
+		return false;
+
+	const auto numSamples = static_cast<int> (reader->lengthInSamples);
+
+	audio.setSize (static_cast<int> (reader->numChannels), numSamples);
+	samplerate = reader->sampleRate;
+
+	return reader->read (&audio, 0, numSamples, 0, true, true);
+}
+
+bool OfflineRenderer::loadMidi (const juce::File& file, juce::MidiMessageSequence& midi)
+{
+	juce::FileInputStream stream (file);
+
+	if (! stream.openedOk())
+		return false;
+
+	juce::MidiFile midiFile;
+
+	if (! midiFile.readFrom (stream))
+		return false;
+
+	midiFile.convertTimestampTicksToSeconds();
+
+	midi.clear();
+
+	for (int i = 0; i < midiFile.getNumTracks(); ++i)
+		midi.addSequence (*midiFile.getTrack (i), 0.);
+
+	midi.sort();
+	midi.updateMatchedPairs();
+
+	return true;
+}
+
+bool OfflineRenderer::writeAudio (const juce::File& file, const juce::AudioBuffer<float>& audio, double samplerate, int bitDepth)
+{
+	file.deleteFile();
+
+	auto stream = std::make_unique<juce::FileOutputStream> (file);
+
+	if (! stream->openedOk())
+		return false;
+
+	juce::WavAudioFormat format;
+
+	std::unique_ptr<juce::AudioFormatWriter> writer (format.createWriterFor (stream.get(), samplerate,
+																			 static_cast<unsigned int> (audio.getNumChannels()),
+																			 bitDepth, {}, 0));
+
+	if (writer == nullptr)
+		return false;
+
+	stream.release();  // the writer now owns the stream
+
+	return writer->writeFromAudioSampleBuffer (audio, 0, audio.getNumSamples());
+}
+
+bool OfflineRenderer::writeTrace (const juce::File& file)
+{
+	file.deleteFile();
+
+	juce::FileOutputStream stream (file);
+
+	if (! stream.openedOk())
+		return false;
+
+	juce::StringArray parameterNames;
+
+	for (auto* param : getProcessor().getParameters())
+		parameterNames.add (param->getName (100));
+
+	processor.getTrace().writeChromeTrace (stream, parameterNames);
+
+	stream.flush();
+
+	return stream.getStatus().wasOk();
+}
+
+
+struct RenderWorker : juce::Thread
+{
+	RenderWorker (const std::vector<RenderJob>& jobsToUse, juce::StringArray& resultsToUse,
+				  std::atomic<int>& nextJobToUse, const RenderSettings& settings)
+		: juce::Thread ("Imogen render worker"), jobs (jobsToUse), results (resultsToUse), nextJob (nextJobToUse), renderer (settings)
+	{
+	}
+
+	void run() final
+	{
+		for (auto i = nextJob++; i < static_cast<int> (jobs.size()); i = nextJob++)
+			results.getReference (i) = renderer.render (jobs[static_cast<size_t> (i)]);
+	}
+
+	const std::vector<RenderJob>& jobs;
+	juce::StringArray&			  results;
+	std::atomic<int>&			  nextJob;
+
+	OfflineRenderer renderer;
+};
+
+juce::StringArray renderInParallel (const std::vector<RenderJob>& jobs, const RenderSettings& settings, int numThreads)
+{
+	const auto numJobs = static_cast<int> (jobs.size());
+
+	juce::StringArray results;
+
+	for (int i = 0; i < numJobs; ++i)
+		results.add ({});
+
+	if (numThreads <= 0)
+		numThreads = juce::SystemStats::getNumCpus();
+
+	numThreads = juce::jlimit (1, juce::jmax (1, numJobs), numThreads);
+
+	std::atomic<int> nextJob { 0 };
+
+	// the processors are created here, on the calling thread; only the rendering happens on the workers
+	juce::OwnedArray<RenderWorker> workers;
+
+	for (int i = 0; i < numThreads; ++i)
+		workers.add (new RenderWorker (jobs, results, nextJob, settings));
+
+	for (auto* worker : workers)
+		worker->startThread();
+
+	for (auto* worker : workers)
+		worker->waitForThreadToExit (-1);
+
+	return results;
+}
+
+}  // namespace Imogen
@@ -0,0 +1,83 @@
+#pragma once
+
+namespace Imogen
+{
+struct RenderJob
+{
+	juce::File audioInput, midiInput, output;
+};
+
+struct RenderSettings
+{
+	juce::File preset;
+
+	bool doublePrecision { false };
+
+	int blocksize { 512 };
+
+	int outputBitDepth { 24 };
+
+	/* An optional Scala scale and keyboard mapping to render with. Every job fails if they can't be loaded. */
+	juce::File scale, keyboardMapping;
+
+	/* Writes a Chrome trace of each render next to its output, as <output>.trace.json */
+	bool writeTrace { false };
+};
+
+
+/* Drives a headless Imogen Processor faster than real time, with the host's non-realtime flag set. */
+class OfflineRenderer
+{
+public:
+
+	OfflineRenderer (const RenderSettings& settingsToUse);
+
+	/* Renders one job on the calling thread. Returns an error message, or an empty string on success. */
+	juce::String render (const RenderJob& job);
+
+	/* Replays a flight recorder capture: restores the processor's state, then renders the captured input, with the realtime
+	   quality profile, and with its MIDI and parameter changes applied at the positions they were recorded at.
+	   Returns an error message, or an empty string on success.
+	*/
+	juce::String replay (const juce::File& captureFolder, const juce::File& output);
+
+	/* Renders an in-memory signal. The output is latency compensated and includes the processor's tail. */
+	void render (const juce::AudioBuffer<float>& input, const juce::MidiMessageSequence& midi,
+				 double samplerate, juce::AudioBuffer<float>& output);
+
+	juce::AudioProcessor& getProcessor() noexcept { return processor; }
+
+	static bool loadAudio (const juce::File& file, juce::AudioBuffer<float>& audio, double& samplerate);
+	static bool loadMidi (const juce::File& file, juce::MidiMessageSequence& midi);
+	static bool writeAudio (const juce::File& file, const juce::AudioBuffer<float>& audio, double samplerate, int bitDepth);
+
+	/* Writes everything the processor's trace recorded, as Chrome trace JSON. */
+	bool writeTrace (const juce::File& file);
+
+private:
+
+	template <typename SampleType>
+	void renderBlocks (const juce::AudioBuffer<float>& input, const juce::MidiMessageSequence& midi,
+					   double samplerate, juce::AudioBuffer<float>& output);
+
+	void applyAutomation (int startSample, int numSamples);
+
+	RenderSettings settings;
+
+	// set if the preset or tuning couldn't be loaded, which fails every job
+	juce::String setupError;
+
+	Processor processor;
+
+	// the parameter changes being replayed, if any, and the next one to apply
+	const std::vector<FlightRecorder::Event>* automation { nullptr };
+	size_t									  nextAutomationEvent { 0 };
+};
+
+
+/* Renders the jobs on up to numThreads threads, each of which owns its own OfflineRenderer.
+   Returns one message per job; an empty string means that job succeeded.
+*/
+juce::StringArray renderInParallel (const std::vector<RenderJob>& jobs, const RenderSettings& settings, int numThreads);
+
+}  // namespace Imogen
@@ -0,0 +1,288 @@
+
+namespace Imogen
+{
+RealtimeSafetyCheck::RealtimeSafetyCheck (bool useDoublePrecision, double samplerateToUse, int blocksizeToUse)
+	: doublePrecision (useDoublePrecision), samplerate (samplerateToUse), blocksize (blocksizeToUse)
+{
+	input.setSize (2, juce::roundToInt (samplerate * 4.));
+	TestSignals::generateVocal (input, samplerate);
+
+	floatBlock.setSize (2, blocksize);
+	doubleBlock.setSize (2, blocksize);
+}
+
+juce::Array<RealtimeSafetyCheck::Result> RealtimeSafetyCheck::run()
+{
+	juce::Array<Result> results;
+
+	const auto scripts = getMidiScripts();
+
+	for (const auto& mode : getModes())
+	{
+		prepare (mode);
+
+		const auto prefix = mode.name.isEmpty() ? juce::String() : mode.name + ": ";
+
+		for (const auto& script : scripts)
+			results.add (checkScript (prefix + script.first, script.second));
+
+		// every parameter is only swept in the default mode
+		if (mode.name.isEmpty())
+			for (auto* param : static_cast<juce::AudioProcessor&> (*processor).getParameters())
+				results.add (checkParameter (*param));
+	}
+
+	processor.reset();
+
+	return results;
+}
+
+/*
+	The first mode leaves everything at its default. Each of the others switches on one of the engine's optional paths,
+	so that every feature that runs on the audio thread is driven by every MIDI script at least once.
+*/
+std::vector<RealtimeSafetyCheck::Mode> RealtimeSafetyCheck::getModes()
+{
+	return {
+		{ {}, {} },
+		{ "Parallel post-harmony", { { "Parallel post-harmony processing", 1.f }, { "Reverb toggle", 1.f } } },
+		{ "Pipelined analysis", { { "Pipelined analysis", 1.f } } },
+		{ "Fixed internal samplerate", { { "Fixed internal samplerate", 1.f } } },
+		{ "Draft quality", { { "Realtime quality", 0.f } } },
+		{ "Quality governor", { { "Forced quality tier", 1.f }, { "Reverb toggle", 1.f } } },
+		{ "MIDI output", { { "MIDI output of harmony and lead", 1.f } } },
+		{ "Auto harmony", { { "Auto harmony", 1.f }, { "Auto harmony voicing", 1.f } } },
+		{ "Unison", { { "Unison voices", 1.f }, { "Unison detune", 1.f } } },
+		{ "Formant preservation", { { "Formant preservation", 1.f } } },
+		{ "Unvoiced fast path", { { "Unvoiced fast path", 1.f } } },
+		{ "Flight recorder", { { "Flight recorder", 1.f } } }
+	};
+}
+
+void RealtimeSafetyCheck::prepare (const Mode& mode)
+{
+	processor = std::make_unique<Processor>();
+
+	auto& proc = static_cast<juce::AudioProcessor&> (*processor);
+
+	proc.setNonRealtime (false);
+
+	for (const auto& setting : mode.settings)
+	{
+		auto found = false;
+
+		for (auto* param : proc.getParameters())
+		{
+			if (param->getName (100) == setting.first)
+			{
+				param->setValueNotifyingHost (setting.second);
+				found = true;
+			}
+		}
+
+		// a renamed parameter would otherwise quietly leave its mode untested
+		jassert (found);
+		juce::ignoreUnused (found);
+	}
+
+	const auto useDouble = doublePrecision && proc.supportsDoublePrecisionProcessing();
+
+	proc.setProcessingPrecision (useDouble ? juce::AudioProcessor::doublePrecision : juce::AudioProcessor::singlePrecision);
+
+	proc.prepareToPlay (samplerate, blocksize);
+
+	inputPosition = 0;
+
+	// lets the engine fill its latency buffers and run any first-time setup outside of the checks
+	processBlocks (8);
+}
+
+void RealtimeSafetyCheck::processBlock (juce::MidiBuffer& midi)
+{
+	auto& proc = static_cast<juce::AudioProcessor&> (*processor);
+
+	if (inputPosition + blocksize > input.getNumSamples())
+		inputPosition = 0;
+
+	for (int chan = 0; chan < 2; ++chan)
+	{
+		floatBlock.copyFrom (chan, 0, input, chan, inputPosition, blocksize);
+
+		const auto* in	= input.getReadPointer (chan, inputPosition);
+		auto*		out = doubleBlock.getWritePointer (chan);
+
+		for (int s = 0; s < blocksize; ++s)
+			out[s] = static_cast<double> (in[s]);
+	}
+
+	inputPosition += blocksize;
+
+	IMOGEN_REALTIME_SCOPE;
+
+	if (proc.isUsingDoublePrecision())
+		proc.processBlock (doubleBlock, midi);
+	else
+		proc.processBlock (floatBlock, midi);
+}
+
+void RealtimeSafetyCheck::processBlocks (int numBlocks)
+{
+	for (int i = 0; i < numBlocks; ++i)
+	{
+		emptyMidi.clear();
+		processBlock (emptyMidi);
+	}
+}
+
+RealtimeSafetyCheck::Result RealtimeSafetyCheck::checkScript (const juce::String& name, const Script& script)
+{
+	RealtimeChecker::resetViolations();
+
+	// like a host's, the buffer is only ever as big as the messages put into it
+	juce::MidiBuffer midi;
+
+	for (const auto& block : script)
+	{
+		midi.clear();
+		midi.addEvents (block, 0, -1, 0);
+
+		processBlock (midi);
+	}
+
+	// lets any released notes finish inside the check too
+	processBlocks (16);
+
+	return { name, RealtimeChecker::getNumViolations() };
+}
+
+RealtimeSafetyCheck::Result RealtimeSafetyCheck::checkParameter (juce::AudioProcessorParameter& param)
+{
+	juce::MidiBuffer chord;
+	TestSignals::addChord (chord, TestSignals::getChordNotes (4));
+
+	processBlock (chord);
+
+	RealtimeChecker::resetViolations();
+
+	// hosts apply automation with setValue() on the audio thread, so the changes are made inside the realtime scope
+	for (const auto value : { 0.f, 1.f, 0.5f, param.getDefaultValue() })
+	{
+		{
+			IMOGEN_REALTIME_SCOPE;
+			param.setValue (value);
+		}
+
+		processBlocks (4);
+	}
+
+	const auto numViolations = RealtimeChecker::getNumViolations();
+
+	juce::MidiBuffer allNotesOff;
+	allNotesOff.addEvent (juce::MidiMessage::allNotesOff (1), 0);
+
+	processBlock (allNotesOff);
+	processBlocks (16);
+
+	return { "Parameter: " + param.getName (100), numViolations };
+}
+
+std::vector<std::pair<juce::String, RealtimeSafetyCheck::Script>> RealtimeSafetyCheck::getMidiScripts()
+{
+	using juce::MidiMessage;
+
+	const auto makeBlock = [] (std::initializer_list<MidiMessage> messages)
+	{
+		juce::MidiBuffer block;
+
+		for (const auto& message : messages)
+			block.addEvent (message, 0);
+
+		return block;
+	};
+
+	const auto chord	 = TestSignals::getChordNotes (4);
+	const auto manyNotes = TestSignals::getChordNotes (24, 24);
+
+	const auto chordOn = [&]
+	{
+		juce::MidiBuffer block;
+		TestSignals::addChord (block, chord);
+		return block;
+	}();
+
+	const auto chordOff = [&]
+	{
+		juce::MidiBuffer block;
+
+		for (const auto note : chord)
+			block.addEvent (MidiMessage::noteOff (1, note), 0);
+
+		return block;
+	}();
+
+	std::vector<std::pair<juce::String, Script>> scripts;
+
+	scripts.push_back ({ "Single note",
+						 { makeBlock ({ MidiMessage::noteOn (1, 60, 0.8f) }),
+						   {},
+						   {},
+						   makeBlock ({ MidiMessage::noteOff (1, 60) }) } });
+
+	scripts.push_back ({ "Repeated note",
+						 { makeBlock ({ MidiMessage::noteOn (1, 60, 0.8f) }),
+						   makeBlock ({ MidiMessage::noteOn (1, 60, 0.5f) }),
+						   makeBlock ({ MidiMessage::noteOff (1, 60) }),
+						   makeBlock ({ MidiMessage::noteOff (1, 60) }) } });
+
+	scripts.push_back ({ "Chord", { chordOn, {}, {}, chordOff } });
+
+	{
+		juce::MidiBuffer stealing;
+		TestSignals::addChord (stealing, manyNotes);
+
+		scripts.push_back ({ "Voice stealing", { stealing, {}, makeBlock ({ MidiMessage::allNotesOff (1) }) } });
+	}
+
+	{
+		Script bend { chordOn };
+
+		for (auto value = 0; value <= 16383; value += 2048)
+			bend.push_back (makeBlock ({ MidiMessage::pitchWheel (1, value) }));
+
+		bend.push_back (makeBlock ({ MidiMessage::pitchWheel (1, 8192) }));
+		bend.push_back (chordOff);
+
+		scripts.push_back ({ "Pitch bend", bend });
+	}
+
+	scripts.push_back ({ "Aftertouch",
+						 { chordOn,
+						   makeBlock ({ MidiMessage::channelPressureChange (1, 100) }),
+						   makeBlock ({ MidiMessage::aftertouchChange (1, chord[0], 127) }),
+						   makeBlock ({ MidiMessage::channelPressureChange (1, 0) }),
+						   chordOff } });
+
+	// sustain, sostenuto and soft pedals
+	scripts.push_back ({ "Pedals",
+						 { chordOn,
+						   makeBlock ({ MidiMessage::controllerEvent (1, 64, 127),
+										MidiMessage::controllerEvent (1, 66, 127),
+										MidiMessage::controllerEvent (1, 67, 127) }),
+						   chordOff,
+						   makeBlock ({ MidiMessage::controllerEvent (1, 64, 0),
+										MidiMessage::controllerEvent (1, 66, 0),
+										MidiMessage::controllerEvent (1, 67, 0) }) } });
+
+	scripts.push_back ({ "Other controllers",
+						 { chordOn,
+						   makeBlock ({ MidiMessage::controllerEvent (1, 1, 64),
+										MidiMessage::controllerEvent (1, 7, 100),
+										MidiMessage::controllerEvent (1, 10, 32) }),
+						   makeBlock ({ MidiMessage::programChange (1, 5) }),
+						   makeBlock ({ MidiMessage::allSoundOff (1) }),
+						   makeBlock ({ MidiMessage::allNotesOff (1) }) } });
+
+	return scripts;
+}
+
+}  // namespace Imogen
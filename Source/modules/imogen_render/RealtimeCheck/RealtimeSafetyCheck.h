@@ -0,0 +1,62 @@
+#pragma once
+
+namespace Imogen
+{
+/* Exercises every parameter and MIDI path of a headless Imogen Processor, in each of the engine's processing modes,
+   with every processBlock() call inside a realtime scope, and counts the violations each scenario causes.
+   The counts are only meaningful in builds with IMOGEN_RT_CHECK enabled; the offending stacks go to stderr.
+*/
+class RealtimeSafetyCheck
+{
+public:
+
+	struct Result
+	{
+		juce::String scenario;
+		int			 numViolations { 0 };
+	};
+
+	RealtimeSafetyCheck (bool useDoublePrecision, double samplerate = 48000., int blocksize = 512);
+
+	juce::Array<Result> run();
+
+private:
+
+	/* A set of parameters, by name, and the normalised values they're set to before the engine is prepared. */
+	struct Mode
+	{
+		juce::String								name;
+		std::vector<std::pair<juce::String, float>> settings;
+	};
+
+	static std::vector<Mode> getModes();
+
+	/* Each MidiBuffer is given to one block, in order. */
+	using Script = std::vector<juce::MidiBuffer>;
+
+	static std::vector<std::pair<juce::String, Script>> getMidiScripts();
+
+	Result checkScript (const juce::String& name, const Script& script);
+	Result checkParameter (juce::AudioProcessorParameter& param);
+
+	void prepare (const Mode& mode);
+
+	void processBlock (juce::MidiBuffer& midi);
+
+	void processBlocks (int numBlocks);
+
+	bool   doublePrecision;
+	double samplerate;
+	int	   blocksize;
+
+	std::unique_ptr<Processor> processor;
+
+	juce::AudioBuffer<float>  input, floatBlock;
+	juce::AudioBuffer<double> doubleBlock;
+
+	juce::MidiBuffer emptyMidi;
+
+	int inputPosition { 0 };
+};
+
+}  // namespace Imogen
@@ -0,0 +1,219 @@
+
+namespace Imogen
+{
+RegressionSuite::RegressionSuite (const RegressionSettings& settingsToUse)
+	: settings (settingsToUse)
+{
+}
+
+juce::Array<RegressionCase> RegressionSuite::getCorpus()
+{
+	const auto allEffects = [] (float value)
+	{
+		std::vector<std::pair<juce::String, float>> params;
+
+		for (const auto& toggle : Benchmark::getEffectToggleNames())
+			params.emplace_back (toggle, value);
+
+		return params;
+	};
+
+	juce::Array<RegressionCase> corpus;
+
+	{
+		RegressionCase c;
+		c.name		 = "lead-only";
+		c.parameters = { { "Harmony bypass", 1.f } };
+		corpus.add (c);
+	}
+
+	{
+		RegressionCase c;
+		c.name	= "chord-4-defaults";
+		c.chord = TestSignals::getChordNotes (4);
+		corpus.add (c);
+	}
+
+	{
+		RegressionCase c;
+		c.name		 = "chord-4-no-effects";
+		c.chord		 = TestSignals::getChordNotes (4);
+		c.parameters = allEffects (0.f);
+		corpus.add (c);
+	}
+
+	{
+		RegressionCase c;
+		c.name		 = "chord-8-all-effects";
+		c.chord		 = TestSignals::getChordNotes (8);
+		c.parameters = allEffects (1.f);
+		corpus.add (c);
+	}
+
+	{
+		RegressionCase c;
+		c.name		 = "chord-4-pitch-glide";
+		c.chord		 = TestSignals::getChordNotes (4);
+		c.parameters = { { "Pitch glide toggle", 1.f } };
+		corpus.add (c);
+	}
+
+	{
+		RegressionCase c;
+		c.name		 = "chord-4-44k1-64-samples";
+		c.samplerate = 44100.;
+		c.blocksize	 = 64;
+		c.chord		 = TestSignals::getChordNotes (4);
+		corpus.add (c);
+	}
+
+	{
+		RegressionCase c;
+		c.name		 = "chord-4-96k";
+		c.samplerate = 96000.;
+		c.chord		 = TestSignals::getChordNotes (4);
+		corpus.add (c);
+	}
+
+	return corpus;
+}
+
+juce::Array<RegressionResult> RegressionSuite::run()
+{
+	auto baselines = juce::JSON::parse (getBaselinesFile());
+
+	if (! baselines.isObject())
+		baselines = new juce::DynamicObject();
+
+	if (settings.record)
+		settings.goldenFolder.createDirectory();
+
+	juce::Array<RegressionResult> results;
+
+	for (const auto& regressionCase : getCorpus())
+		results.add (runCase (regressionCase, *baselines.getDynamicObject()));
+
+	if (settings.record)
+		getBaselinesFile().replaceWithText (juce::JSON::toString (baselines));
+
+	return results;
+}
+
+RegressionResult RegressionSuite::runCase (const RegressionCase& regressionCase, juce::DynamicObject& baselines)
+{
+	RegressionResult result;
+	result.caseName = regressionCase.name;
+
+	juce::AudioBuffer<float> output;
+
+	auto fastest = std::numeric_limits<double>::max();
+
+	for (int run = 0; run < juce::jmax (1, settings.timingRuns); ++run)
+		fastest = juce::jmin (fastest, render (regressionCase, output));
+
+	result.realtimeFactor = fastest > 0. ? regressionCase.seconds / fastest : 0.;
+
+	const auto goldenFile  = getGoldenFile (regressionCase);
+	const auto baselineKey = goldenFile.getFileNameWithoutExtension();
+
+	if (settings.record)
+	{
+		if (! OfflineRenderer::writeAudio (goldenFile, output, regressionCase.samplerate, 32))
+			result.failure = "Could not write " + goldenFile.getFullPathName();
+
+		baselines.setProperty (baselineKey, result.realtimeFactor);
+		result.baselineRealtimeFactor = result.realtimeFactor;
+
+		return result;
+	}
+
+	juce::AudioBuffer<float> golden;
+	double					 goldenSamplerate = 0.;
+
+	if (! OfflineRenderer::loadAudio (goldenFile, golden, goldenSamplerate))
+	{
+		result.failure = "No golden output at " + goldenFile.getFullPathName();
+		return result;
+	}
+
+	if (golden.getNumSamples() != output.getNumSamples() || golden.getNumChannels() != output.getNumChannels())
+	{
+		result.failure = "Output length or channel count differs from the golden";
+		return result;
+	}
+
+	for (int chan = 0; chan < output.getNumChannels(); ++chan)
+	{
+		const auto* actual	 = output.getReadPointer (chan);
+		const auto* expected = golden.getReadPointer (chan);
+
+		for (int s = 0; s < output.getNumSamples(); ++s)
+			result.maxDifference = juce::jmax (result.maxDifference, std::abs (actual[s] - expected[s]));
+	}
+
+	if (result.maxDifference > settings.tolerance)
+		result.failure = "Output differs from the golden by up to " + juce::String (result.maxDifference);
+
+	if (baselines.hasProperty (baselineKey))
+	{
+		result.baselineRealtimeFactor = baselines.getProperty (baselineKey);
+
+		const auto slowdown = (1. - result.realtimeFactor / result.baselineRealtimeFactor) * 100.;
+
+		if (slowdown > settings.maxSlowdownPercent)
+			result.failure << (result.failure.isEmpty() ? "" : "; ")
+						   << "Throughput is " << juce::String (slowdown, 1) << "% below its baseline";
+	}
+
+	return result;
+}
+
+double RegressionSuite::render (const RegressionCase& regressionCase, juce::AudioBuffer<float>& output) const
+{
+	RenderSettings renderSettings;
+
+	renderSettings.doublePrecision = settings.doublePrecision;
+	renderSettings.blocksize	   = regressionCase.blocksize;
+
+	OfflineRenderer renderer { renderSettings };
+
+	for (auto* param : renderer.getProcessor().getParameters())
+	{
+		const auto name = param->getName (100);
+
+		for (const auto& [paramName, value] : regressionCase.parameters)
+			if (name == paramName)
+				param->setValueNotifyingHost (value);
+	}
+
+	juce::AudioBuffer<float> input (2, juce::roundToInt (regressionCase.seconds * regressionCase.samplerate));
+	TestSignals::generateVocal (input, regressionCase.samplerate);
+
+	juce::MidiMessageSequence midi;
+
+	for (const auto note : regressionCase.chord)
+	{
+		midi.addEvent (juce::MidiMessage::noteOn (1, note, 0.8f).withTimeStamp (0.));
+		midi.addEvent (juce::MidiMessage::noteOff (1, note).withTimeStamp (regressionCase.seconds - 1.));
+	}
+
+	midi.sort();
+
+	const auto start = juce::Time::getHighResolutionTicks();
+
+	renderer.render (input, midi, regressionCase.samplerate, output);
+
+	return juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+}
+
+juce::File RegressionSuite::getGoldenFile (const RegressionCase& regressionCase) const
+{
+	return settings.goldenFolder.getChildFile (regressionCase.name + (settings.doublePrecision ? "-double" : "-float") + ".wav");
+}
+
+juce::File RegressionSuite::getBaselinesFile() const
+{
+	return settings.goldenFolder.getChildFile ("baselines.json");
+}
+
+}  // namespace Imogen
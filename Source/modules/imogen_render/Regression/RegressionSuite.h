@@ -0,0 +1,79 @@
+#pragma once
+
+namespace Imogen
+{
+struct RegressionCase
+{
+	juce::String name;
+
+	double samplerate { 48000. };
+	int	   blocksize { 512 };
+	double seconds { 6. };
+
+	/* Notes held from the start until one second before the end. */
+	juce::Array<int> chord;
+
+	/* Normalised values for parameters, by name; every other parameter stays at its default. */
+	std::vector<std::pair<juce::String, float>> parameters;
+};
+
+struct RegressionSettings
+{
+	/* Holds a golden output for each case, and the baseline throughputs. */
+	juce::File goldenFolder;
+
+	/* Writes new goldens and baselines instead of comparing against them. */
+	bool record { false };
+
+	bool doublePrecision { false };
+
+	/* The largest difference allowed between any output sample and its golden. */
+	float tolerance { 1.0e-4f };
+
+	/* How much slower than its baseline a case may render before it fails. */
+	double maxSlowdownPercent { 10. };
+
+	/* Each case is rendered this many times and the fastest is kept, to keep the throughput stable. */
+	int timingRuns { 3 };
+};
+
+struct RegressionResult
+{
+	juce::String caseName;
+
+	float maxDifference { 0.f };
+
+	double realtimeFactor { 0. }, baselineRealtimeFactor { 0. };
+
+	/* Empty if the case passed. */
+	juce::String failure;
+};
+
+
+/* Renders a fixed, generated corpus through the engine with fixed parameters, compares each output against its stored golden,
+   and checks each case's throughput against a stored baseline.
+   The goldens and baselines are separate for each precision; baselines are only comparable on the machine that recorded them.
+*/
+class RegressionSuite
+{
+public:
+
+	RegressionSuite (const RegressionSettings& settingsToUse);
+
+	juce::Array<RegressionResult> run();
+
+	static juce::Array<RegressionCase> getCorpus();
+
+private:
+
+	RegressionResult runCase (const RegressionCase& regressionCase, juce::DynamicObject& baselines);
+
+	double render (const RegressionCase& regressionCase, juce::AudioBuffer<float>& output) const;
+
+	juce::File getGoldenFile (const RegressionCase& regressionCase) const;
+	juce::File getBaselinesFile() const;
+
+	RegressionSettings settings;
+};
+
+}  // namespace Imogen
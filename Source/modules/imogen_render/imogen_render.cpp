@@ -0,0 +1,10 @@
+#include "imogen_render.h"
+
+#include "OfflineRenderer/OfflineRenderer.cpp"
+
+#include "Benchmark/TestSignals.cpp"
+#include "Benchmark/Benchmark.cpp"
+
+#include "RealtimeCheck/RealtimeSafetyCheck.cpp"
+
+#include "Regression/RegressionSuite.cpp"
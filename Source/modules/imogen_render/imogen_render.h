@@ -0,0 +1,24 @@
+#pragma once
+
+/*-------------------------------------------------------------------------------------
+
+ BEGIN_JUCE_MODULE_DECLARATION
+
+ ID:                 imogen_render
+ vendor:             Ben Vining
+ version:            0.0.1
+ name:               imogen_render
+ description:        Headless offline rendering for Imogen
+ dependencies:       imogen_dsp juce_audio_formats
+
+ END_JUCE_MODULE_DECLARATION
+
+-------------------------------------------------------------------------------------*/
+
+#include <imogen_dsp/imogen_dsp.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include "OfflineRenderer/OfflineRenderer.h"
+#include "Benchmark/Benchmark.h"
+#include "RealtimeCheck/RealtimeSafetyCheck.h"
+#include "Regression/RegressionSuite.h"
@@ -1,3 +1,7 @@
 #include "imogen_state.h"
 
 #include "state/State.cpp"
+#include "state/StageTimings.cpp"
+#include "state/TraceRecorder.cpp"
+#include "state/FlightRecorder.cpp"
+#include "state/TuningTable.cpp"
@@ -0,0 +1,325 @@
+
+namespace Imogen
+{
+void FlightRecorder::setParameters (const juce::Array<juce::AudioProcessorParameter*>& parametersToRecord)
+{
+	jassert (! isArmed());
+
+	parameters = parametersToRecord;
+}
+
+void FlightRecorder::prepare (double samplerateToUse, int maxBlocksizeToUse, int numChannels)
+{
+	release();
+
+	const juce::ScopedLock sl (allocationLock);
+
+	samplerate	  = samplerateToUse;
+	maxBlocksize  = juce::jmax (1, maxBlocksizeToUse);
+	windowSamples = juce::roundToInt (windowSeconds * samplerate);
+
+	// the extra second leaves a reader plenty of time to copy the window before the writer catches up with it
+	audioRing.setSize (juce::jmax (1, numChannels), windowSamples + juce::roundToInt (samplerate) + maxBlocksize);
+	audioRing.clear();
+
+	const auto maxBlocksInWindow = windowSamples / juce::jmin (maxBlocksize, 32) + 64;
+
+	// room for an average of two MIDI messages or parameter changes per block, across the whole window
+	eventRing.resize (static_cast<size_t> (juce::nextPowerOfTwo (maxBlocksInWindow * 2)));
+	timingRing.resize (static_cast<size_t> (juce::nextPowerOfTwo (maxBlocksInWindow)));
+
+	lastParameterValues.resize (static_cast<size_t> (parameters.size()));
+
+	for (int i = 0; i < parameters.size(); ++i)
+		lastParameterValues[static_cast<size_t> (i)] = parameters.getUnchecked (i)->getValue();
+
+	for (auto& start : heldNoteStarts)
+		start.store (-1);
+
+	samplesWritten.store (0);
+	eventsWritten.store (0);
+	timingsWritten.store (0);
+
+	lastBlockPosition = 0;
+	lastBlockSize	  = 0;
+
+	armed.store (true);
+}
+
+void FlightRecorder::release()
+{
+	const juce::ScopedLock sl (allocationLock);
+
+	armed.store (false);
+
+	audioRing.setSize (0, 0);
+	eventRing.clear();
+	timingRing.clear();
+}
+
+bool FlightRecorder::isArmed() const noexcept
+{
+	return armed.load (std::memory_order_relaxed);
+}
+
+template <typename SampleType>
+void FlightRecorder::recordBlock (const juce::AudioBuffer<SampleType>& input, const juce::MidiBuffer& midi) noexcept
+{
+	if (! isArmed())
+		return;
+
+	const auto position	  = samplesWritten.load (std::memory_order_relaxed);
+	const auto numSamples = juce::jmin (input.getNumSamples(), maxBlocksize);
+	const auto capacity	  = audioRing.getNumSamples();
+
+	for (int i = 0; i < parameters.size(); ++i)
+	{
+		const auto value = parameters.getUnchecked (i)->getValue();
+		auto&	   last	 = lastParameterValues[static_cast<size_t> (i)];
+
+		if (value == last)
+			continue;
+
+		Event event;
+		event.position		 = position;
+		event.parameterIndex = parameters.getUnchecked (i)->getParameterIndex();
+		event.oldValue		 = last;
+		event.newValue		 = value;
+
+		recordEvent (event);
+
+		last = value;
+	}
+
+	for (const auto metadata : midi)
+	{
+		if (metadata.numBytes > 3)
+			continue;
+
+		Event event;
+		event.position = position + metadata.samplePosition;
+		event.midiSize = metadata.numBytes;
+
+		std::copy (metadata.data, metadata.data + metadata.numBytes, event.midiData.begin());
+
+		recordEvent (event);
+
+		const auto message = metadata.getMessage();
+
+		if (! message.isNoteOnOrOff())
+			continue;
+
+		auto& heldStart = heldNoteStarts[static_cast<size_t> (getNoteIndex (message.getChannel(), message.getNoteNumber()))];
+
+		heldStart.store (message.isNoteOn() ? event.position : -1, std::memory_order_relaxed);
+	}
+
+	for (int chan = 0; chan < audioRing.getNumChannels(); ++chan)
+	{
+		const auto* in	= input.getReadPointer (juce::jmin (chan, input.getNumChannels() - 1));
+		auto*		out = audioRing.getWritePointer (chan);
+
+		auto writePos = static_cast<int> (position % capacity);
+
+		for (int s = 0; s < numSamples; ++s)
+		{
+			out[writePos] = static_cast<float> (in[s]);
+
+			if (++writePos == capacity)
+				writePos = 0;
+		}
+	}
+
+	lastBlockPosition = position;
+	lastBlockSize	  = numSamples;
+
+	samplesWritten.store (position + numSamples, std::memory_order_release);
+}
+
+template void FlightRecorder::recordBlock (const juce::AudioBuffer<float>&, const juce::MidiBuffer&) noexcept;
+template void FlightRecorder::recordBlock (const juce::AudioBuffer<double>&, const juce::MidiBuffer&) noexcept;
+
+void FlightRecorder::recordEvent (const Event& event) noexcept
+{
+	const auto index = eventsWritten.load (std::memory_order_relaxed);
+
+	eventRing[static_cast<size_t> (index % eventRing.size())] = event;
+
+	eventsWritten.store (index + 1, std::memory_order_release);
+}
+
+void FlightRecorder::recordLoad (double load) noexcept
+{
+	if (! isArmed())
+		return;
+
+	const auto index = timingsWritten.load (std::memory_order_relaxed);
+
+	timingRing[static_cast<size_t> (index % timingRing.size())] = { lastBlockPosition, lastBlockSize, static_cast<float> (load) };
+
+	timingsWritten.store (index + 1, std::memory_order_release);
+
+	if (load > 1.)
+		requestDump();
+}
+
+void FlightRecorder::requestDump() noexcept
+{
+	dumpRequested.store (true);
+}
+
+bool FlightRecorder::takeDumpRequest() noexcept
+{
+	return dumpRequested.exchange (false);
+}
+
+bool FlightRecorder::getCapture (Capture& capture) const
+{
+	const juce::ScopedLock sl (allocationLock);
+
+	if (! isArmed())
+		return false;
+
+	const auto end = samplesWritten.load (std::memory_order_acquire);
+
+	if (end == 0)
+		return false;
+
+	const auto capacity = static_cast<juce::int64> (audioRing.getNumSamples());
+
+	auto start = juce::jmax (juce::int64 (0), end - windowSamples);
+
+	capture.samplerate = samplerate;
+	capture.blocksize  = maxBlocksize;
+
+	capture.audio.setSize (audioRing.getNumChannels(), static_cast<int> (end - start));
+
+	for (int chan = 0; chan < audioRing.getNumChannels(); ++chan)
+	{
+		const auto* in	= audioRing.getReadPointer (chan);
+		auto*		out = capture.audio.getWritePointer (chan);
+
+		for (auto pos = start; pos < end; ++pos)
+			out[pos - start] = in[pos % capacity];
+	}
+
+	// anything the audio thread may have overwritten while the window was being copied is dropped from the front
+	const auto safeStart = samplesWritten.load (std::memory_order_acquire) + maxBlocksize - capacity;
+
+	if (safeStart > start)
+	{
+		const auto numToDrop = static_cast<int> (juce::jmin (safeStart, end) - start);
+
+		for (int chan = 0; chan < capture.audio.getNumChannels(); ++chan)
+			std::memmove (capture.audio.getWritePointer (chan), capture.audio.getReadPointer (chan, numToDrop),
+						  static_cast<size_t> (capture.audio.getNumSamples() - numToDrop) * sizeof (float));
+
+		capture.audio.setSize (capture.audio.getNumChannels(), capture.audio.getNumSamples() - numToDrop, true);
+
+		start += numToDrop;
+	}
+
+	const auto copyRing = [start, end] (const auto& ring, const std::atomic<juce::uint64>& counter, auto& dest)
+	{
+		const auto size		  = static_cast<juce::uint64> (ring.size());
+		const auto numWritten = counter.load (std::memory_order_acquire);
+		const auto first	  = numWritten > size ? numWritten - size : 0;
+
+		std::remove_reference_t<decltype (dest)> copied;
+
+		for (auto i = first; i < numWritten; ++i)
+			copied.push_back (ring[static_cast<size_t> (i % size)]);
+
+		// the slot being written now, and any written during the copy, may have overwritten the oldest items
+		const auto numWrittenAfter = counter.load (std::memory_order_acquire) + 1;
+		const auto safeFirst	   = numWrittenAfter > size ? numWrittenAfter - size : 0;
+		const auto numToSkip	   = static_cast<size_t> (juce::jmin (safeFirst > first ? safeFirst - first : 0, static_cast<juce::uint64> (copied.size())));
+
+		dest.clear();
+
+		for (auto i = numToSkip; i < copied.size(); ++i)
+		{
+			auto item = copied[i];
+
+			if (item.position < start || item.position >= end)
+				continue;
+
+			item.position -= start;
+			dest.push_back (item);
+		}
+	};
+
+	copyRing (eventRing, eventsWritten, capture.events);
+	copyRing (timingRing, timingsWritten, capture.timings);
+
+	// each parameter starts at the value its first change in the window came from, or else at its current value
+	capture.parameterIndices.clearQuick();
+	capture.initialParameterValues.clearQuick();
+
+	for (auto* param : parameters)
+	{
+		capture.parameterIndices.add (param->getParameterIndex());
+		capture.initialParameterValues.add (param->getValue());
+	}
+
+	juce::BigInteger seen;
+
+	for (const auto& event : capture.events)
+	{
+		if (event.parameterIndex < 0 || seen[event.parameterIndex])
+			continue;
+
+		seen.setBit (event.parameterIndex);
+
+		const auto position = capture.parameterIndices.indexOf (event.parameterIndex);
+
+		if (position >= 0)
+			capture.initialParameterValues.set (position, event.oldValue);
+	}
+
+	// notes that were already held when the window started get a note-on at the start
+	std::array<bool, 16 * 128> startedInWindow {};
+	std::vector<Event>		   heldAtStart;
+
+	const auto addNoteOn = [&heldAtStart] (int channel, int note)
+	{
+		Event event;
+		event.midiSize = 3;
+		event.midiData = { static_cast<juce::uint8> (0x90 | (channel - 1)), static_cast<juce::uint8> (note), 100 };
+		heldAtStart.push_back (event);
+	};
+
+	for (const auto& event : capture.events)
+	{
+		if (event.parameterIndex >= 0)
+			continue;
+
+		const juce::MidiMessage message { event.midiData.data(), event.midiSize };
+
+		if (! message.isNoteOnOrOff())
+			continue;
+
+		auto& started = startedInWindow[static_cast<size_t> (getNoteIndex (message.getChannel(), message.getNoteNumber()))];
+
+		if (message.isNoteOn())
+			started = true;
+		else if (! started)
+			addNoteOn (message.getChannel(), message.getNoteNumber());
+	}
+
+	for (int channel = 1; channel <= 16; ++channel)
+		for (int note = 0; note < 128; ++note)
+		{
+			const auto index	 = static_cast<size_t> (getNoteIndex (channel, note));
+			const auto noteStart = heldNoteStarts[index].load (std::memory_order_relaxed);
+
+			if (noteStart >= 0 && noteStart < start && ! startedInWindow[index])
+				addNoteOn (channel, note);
+		}
+
+	capture.events.insert (capture.events.begin(), heldAtStart.begin(), heldAtStart.end());
+
+	return capture.audio.getNumSamples() > 0;
+}
+
+}  // namespace Imogen
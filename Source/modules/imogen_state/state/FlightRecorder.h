@@ -0,0 +1,111 @@
+#pragma once
+
+namespace Imogen
+{
+/* Keeps a rolling window of everything the engine was given - input audio, incoming MIDI and parameter changes -
+   along with how long each block took, so that a glitch can be reproduced offline afterwards.
+   Everything is preallocated by prepare(); recording from the audio thread never allocates or locks,
+   and a capture can be copied out from any other thread while recording carries on.
+*/
+class FlightRecorder
+{
+public:
+
+	static constexpr double windowSeconds = 30.;
+
+	struct Event
+	{
+		juce::int64 position { 0 };
+
+		// the processor's index of the parameter, or -1 for MIDI events
+		int parameterIndex { -1 };
+
+		float oldValue { 0.f }, newValue { 0.f };
+
+		std::array<juce::uint8, 3> midiData {};
+		int						   midiSize { 0 };
+	};
+
+	struct BlockTiming
+	{
+		juce::int64 position { 0 };
+		int			numSamples { 0 };
+		float		load { 0.f };
+	};
+
+	/* Everything in the window, with positions relative to the start of the captured audio. */
+	struct Capture
+	{
+		double samplerate { 0. };
+		int	   blocksize { 0 };
+
+		juce::AudioBuffer<float> audio;
+
+		std::vector<Event>		 events;
+		std::vector<BlockTiming> timings;
+
+		/* The processor's index of each recorded parameter, and its normalised value at the start of the window. */
+		juce::Array<int>   parameterIndices;
+		juce::Array<float> initialParameterValues;
+	};
+
+	/* The parameters whose changes should be recorded, in index order.
+	   Only the ones a host can automate belong here; meters and internals are outputs, or settings of the engine itself. */
+	void setParameters (const juce::Array<juce::AudioProcessorParameter*>& parametersToRecord);
+
+	/* Allocates the window and starts recording. Not realtime safe. */
+	void prepare (double samplerate, int maxBlocksize, int numChannels);
+
+	/* Stops recording and frees the window. Not realtime safe. */
+	void release();
+
+	bool isArmed() const noexcept;
+
+	template <typename SampleType>
+	void recordBlock (const juce::AudioBuffer<SampleType>& input, const juce::MidiBuffer& midi) noexcept;
+
+	/* Records the CPU load of the block last passed to recordBlock(). An overrun requests a dump. */
+	void recordLoad (double load) noexcept;
+
+	void requestDump() noexcept;
+
+	/* Returns true (once) if a dump has been requested since the last call. */
+	bool takeDumpRequest() noexcept;
+
+	/* Copies out the current window. Returns false if nothing has been recorded yet. */
+	bool getCapture (Capture& capture) const;
+
+private:
+
+	void recordEvent (const Event& event) noexcept;
+
+	static int getNoteIndex (int channel, int note) noexcept { return (channel - 1) * 128 + note; }
+
+	juce::Array<juce::AudioProcessorParameter*> parameters;
+
+	std::vector<float> lastParameterValues;
+
+	double samplerate { 0. };
+	int	   maxBlocksize { 0 };
+	int	   windowSamples { 0 };
+
+	juce::AudioBuffer<float> audioRing;
+	std::vector<Event>		 eventRing;
+	std::vector<BlockTiming> timingRing;
+
+	std::atomic<juce::int64>  samplesWritten { 0 };
+	std::atomic<juce::uint64> eventsWritten { 0 }, timingsWritten { 0 };
+
+	// the start position of each note that's currently held, or -1
+	std::array<std::atomic<juce::int64>, 16 * 128> heldNoteStarts;
+
+	juce::int64 lastBlockPosition { 0 };
+	int			lastBlockSize { 0 };
+
+	std::atomic<bool> armed { false }, dumpRequested { false };
+
+	// keeps the window from being reallocated while it's being copied; never taken by the audio thread
+	juce::CriticalSection allocationLock;
+};
+
+}  // namespace Imogen
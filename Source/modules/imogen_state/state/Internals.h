@@ -23,6 +23,32 @@ struct Internals
 
 	BoolParam guiDarkMode { true, "GUI Dark mode" };
 
+	/* These four are applied by preparing the engine again, which briefly interrupts the audio. */
+	BoolParam parallelPostHarmony { false, "Parallel post-harmony processing" };
+
+	BoolParam pipelinedAnalysis { false, "Pipelined analysis" };
+
+	BoolParam fixedInternalRate { false, "Fixed internal samplerate" };
+
+	BoolParam flightRecorderEnabled { false, "Flight recorder" };
+
+	BoolParam qualityGovernor { false, "CPU quality governor" };
+
+	/* Holds the governor at or below a quality tier, so the reduced tiers can be exercised without overloading the CPU. */
+	IntParam forcedQualityTier { 0, 3, 0, "Forced quality tier" };
+
+	/* Skips pitch shifting and correction while the input is unvoiced. */
+	BoolParam unvoicedFastPath { false, "Unvoiced fast path" };
+
+	/* Replaces the MIDI output with the harmony notes being played and the lead's detected pitch. */
+	BoolParam midiOutput { false, "MIDI output of harmony and lead" };
+
+	/* The quality profile used while playing live, and the one used while the host renders offline.
+	   Draft always runs at the fixed internal samplerate and High never does, so the two can report different latencies;
+	   the engine is prepared again whenever the profile in use changes, so the host is told about each one. */
+	IntParam realtimeQuality { 0, 2, 1, "Realtime quality", qualityToString };
+	IntParam offlineQuality { 0, 2, 2, "Offline quality", qualityToString };
+
 	IntParam currentInputNote { -1, 127, -1, "Current input note",
 								[] (int note, int maxLength)
 								{
@@ -44,6 +70,16 @@ struct Internals
 
 private:
 
+	static juce::String qualityToString (int quality, int maxLength)
+	{
+		switch (quality)
+		{
+			case (0) : return TRANS ("Draft").substring (0, maxLength);
+			case (2) : return TRANS ("High").substring (0, maxLength);
+			default : return TRANS ("Standard").substring (0, maxLength);
+		}
+	}
+
 	plugin::ParamUpdater linkPeersUpdater { abletonLinkEnabled, [&]
 											{
 												if (! abletonLinkEnabled->get())
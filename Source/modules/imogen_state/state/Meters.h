@@ -21,12 +21,29 @@ struct Meters
 	GainMeter reverbLevel { "Reverb level", otherMeter };
 	GainMeter delayLevel { "Delay level", otherMeter };
 
+	/* Time spent rendering each block, as a percentage of the block's duration. */
+	IntParam cpuLoad { 0, 1000, 0, "CPU load", percentToString };
+	IntParam cpuLoadPeak { 0, 1000, 0, "CPU load peak", percentToString };
+
+	IntParam blockOverruns { 0, 1000000, 0, "Blocks over CPU budget" };
+
+	/* How far the CPU quality governor has currently reduced quality; 0 is full quality. */
+	IntParam qualityTier { 0, 3, 0, "Quality tier" };
+
+	/* How confident the engine is that the input is being sung, rather than breathed or hissed. */
+	IntParam inputVoicing { 0, 100, 0, "Input voicing", percentToString };
+
 private:
 
 	static constexpr auto inputMeter   = juce::AudioProcessorParameter::inputMeter;
 	static constexpr auto outputMeter  = juce::AudioProcessorParameter::outputMeter;
 	static constexpr auto compLimMeter = juce::AudioProcessorParameter::compressorLimiterGainReductionMeter;
 	static constexpr auto otherMeter   = juce::AudioProcessorParameter::otherMeter;
+
+	static juce::String percentToString (int percent, int maxLength)
+	{
+		return (juce::String (percent) + "%").substring (0, maxLength);
+	}
 };
 
 }  // namespace Imogen
@@ -4,6 +4,8 @@
 #include "sublists/EQState.h"
 #include "sublists/ReverbState.h"
 #include "sublists/MidiState.h"
+#include "sublists/AutoHarmonyState.h"
+#include "sublists/UnisonState.h"
 
 namespace Imogen
 {
@@ -28,6 +30,26 @@ struct Parameters : plugin::ParameterList
 							 return 1;
 						 } };
 
+	/* Changes the latency, so changing it prepares the engine again, which briefly interrupts the audio; so it isn't automatable. */
+	IntParam analysisProfile { 1, 4, 4, "Analysis profile",
+							   [] (int value, int maxLength)
+							   {
+								   switch (value)
+								   {
+									   case (1) : return TRANS ("Soprano").substring (0, maxLength);
+									   case (2) : return TRANS ("Alto").substring (0, maxLength);
+									   case (3) : return TRANS ("Tenor").substring (0, maxLength);
+									   default : return TRANS ("Bass").substring (0, maxLength);
+								   }
+							   },
+							   [] (const juce::String& text)
+							   {
+								   if (text.containsIgnoreCase (TRANS ("Soprano"))) return 1;
+								   if (text.containsIgnoreCase (TRANS ("Alto"))) return 2;
+								   if (text.containsIgnoreCase (TRANS ("Tenor"))) return 3;
+								   return 4;
+							   } };
+
 	PercentParam dryWet { "Main dry/wet", 100 };
 
 	dbParam inputGain { "Input gain", 0.f, juce::AudioProcessorParameter::inputGain };
@@ -59,11 +81,18 @@ struct Parameters : plugin::ParameterList
 
 	ToggleParam limiterToggle { "Limiter toggle", true };
 
+	/* How much of the formant shift from pitch shifting the harmony voices undo. */
+	PercentParam formantPreservation { "Formant preservation", 0 };
+
 	EQState eqState { *this };
 
 	ReverbState reverbState { *this };
 
 	MidiState midiState { *this };
+
+	AutoHarmonyState autoHarmonyState;
+
+	UnisonState unisonState;
 };
 
 
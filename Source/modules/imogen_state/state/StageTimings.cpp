@@ -0,0 +1,129 @@
+
+namespace Imogen
+{
+void StageTimings::Histogram::record (juce::uint64 nanos) noexcept
+{
+	const auto bucket = juce::jmin (numBuckets - 1, nanos == 0 ? 0 : static_cast<int> (std::log2 (static_cast<double> (nanos))));
+
+	buckets[static_cast<size_t> (bucket)].fetch_add (1, std::memory_order_relaxed);
+
+	numCalls.fetch_add (1, std::memory_order_relaxed);
+	totalNanos.fetch_add (nanos, std::memory_order_relaxed);
+
+	auto prevMax = maxNanos.load (std::memory_order_relaxed);
+
+	while (nanos > prevMax && ! maxNanos.compare_exchange_weak (prevMax, nanos, std::memory_order_relaxed))
+	{
+	}
+}
+
+void StageTimings::Histogram::reset() noexcept
+{
+	for (auto& bucket : buckets)
+		bucket.store (0, std::memory_order_relaxed);
+
+	numCalls.store (0, std::memory_order_relaxed);
+	totalNanos.store (0, std::memory_order_relaxed);
+	maxNanos.store (0, std::memory_order_relaxed);
+}
+
+juce::uint64 StageTimings::Histogram::getNumCalls() const noexcept
+{
+	return numCalls.load (std::memory_order_relaxed);
+}
+
+juce::uint64 StageTimings::Histogram::getTotalNanos() const noexcept
+{
+	return totalNanos.load (std::memory_order_relaxed);
+}
+
+juce::uint64 StageTimings::Histogram::getMaxNanos() const noexcept
+{
+	return maxNanos.load (std::memory_order_relaxed);
+}
+
+double StageTimings::Histogram::getAverageNanos() const noexcept
+{
+	const auto calls = getNumCalls();
+
+	if (calls == 0)
+		return 0.;
+
+	return static_cast<double> (getTotalNanos()) / static_cast<double> (calls);
+}
+
+juce::uint64 StageTimings::Histogram::getPercentileNanos (double percentile) const noexcept
+{
+	juce::uint64 total = 0;
+
+	for (const auto& bucket : buckets)
+		total += bucket.load (std::memory_order_relaxed);
+
+	if (total == 0)
+		return 0;
+
+	const auto target = static_cast<juce::uint64> (std::ceil (juce::jlimit (0., 1., percentile) * static_cast<double> (total)));
+
+	juce::uint64 count = 0;
+
+	for (int i = 0; i < numBuckets; ++i)
+	{
+		count += buckets[static_cast<size_t> (i)].load (std::memory_order_relaxed);
+
+		if (count >= target)
+			return juce::uint64 (2) << i;
+	}
+
+	return getMaxNanos();
+}
+
+void StageTimings::record (Stage stage, juce::uint64 nanos) noexcept
+{
+	(*this)[stage].record (nanos);
+}
+
+StageTimings::Histogram& StageTimings::operator[] (Stage stage) noexcept
+{
+	return stages[static_cast<size_t> (stage)];
+}
+
+const StageTimings::Histogram& StageTimings::operator[] (Stage stage) const noexcept
+{
+	return stages[static_cast<size_t> (stage)];
+}
+
+void StageTimings::reset() noexcept
+{
+	for (auto& stage : stages)
+		stage.reset();
+}
+
+juce::String StageTimings::getStageName (Stage stage)
+{
+	switch (stage)
+	{
+		case (Stage::wholeChunk) : return "Whole chunk";
+		case (Stage::preHarmonyEffects) : return "Pre-harmony effects";
+		case (Stage::stereoReducer) : return "Stereo reducer";
+		case (Stage::inputLoCut) : return "Input lo cut";
+		case (Stage::inputGain) : return "Input gain";
+		case (Stage::noiseGate) : return "Noise gate";
+		case (Stage::analysis) : return "Analysis";
+		case (Stage::harmonizer) : return "Harmonizer";
+		case (Stage::lead) : return "Lead";
+		case (Stage::postHarmonyEffects) : return "Post-harmony effects";
+		case (Stage::eq) : return "EQ";
+		case (Stage::compressor) : return "Compressor";
+		case (Stage::deEsser) : return "De-esser";
+		case (Stage::dryWetMixer) : return "Dry/wet mixer";
+		case (Stage::delay) : return "Delay";
+		case (Stage::reverb) : return "Reverb";
+		case (Stage::outputGain) : return "Output gain";
+		case (Stage::limiter) : return "Limiter";
+		case (Stage::numStages) : break;
+	}
+
+	return {};
+}
+
+}  // namespace Imogen
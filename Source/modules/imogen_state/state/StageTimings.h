@@ -0,0 +1,76 @@
+
+#pragma once
+
+namespace Imogen
+{
+/* Per-instance timing histograms for each stage of the engine.
+   Written from the audio thread (and the engine's worker threads) with relaxed atomics; readable from anywhere.
+   The engine only records into this when it's built with IMOGEN_STAGE_TIMING enabled.
+*/
+struct StageTimings
+{
+	enum class Stage
+	{
+		wholeChunk,
+		preHarmonyEffects,
+		stereoReducer,
+		inputLoCut,
+		inputGain,
+		noiseGate,
+		analysis,
+		harmonizer,
+		lead,
+		postHarmonyEffects,
+		eq,
+		compressor,
+		deEsser,
+		dryWetMixer,
+		delay,
+		reverb,
+		outputGain,
+		limiter,
+		numStages
+	};
+
+	static constexpr auto numStages = static_cast<int> (Stage::numStages);
+
+	/* Buckets are powers of two of nanoseconds, so the top bucket holds anything over about one second. */
+	static constexpr int numBuckets = 31;
+
+	struct Histogram
+	{
+		void record (juce::uint64 nanos) noexcept;
+
+		void reset() noexcept;
+
+		juce::uint64 getNumCalls() const noexcept;
+		juce::uint64 getTotalNanos() const noexcept;
+		juce::uint64 getMaxNanos() const noexcept;
+
+		double getAverageNanos() const noexcept;
+
+		/* Returns an upper bound for the given percentile (0-1), read off the histogram buckets. */
+		juce::uint64 getPercentileNanos (double percentile) const noexcept;
+
+	private:
+
+		std::array<std::atomic<juce::uint32>, numBuckets> buckets {};
+
+		std::atomic<juce::uint64> numCalls { 0 }, totalNanos { 0 }, maxNanos { 0 };
+	};
+
+	void record (Stage stage, juce::uint64 nanos) noexcept;
+
+	Histogram&		 operator[] (Stage stage) noexcept;
+	const Histogram& operator[] (Stage stage) const noexcept;
+
+	void reset() noexcept;
+
+	static juce::String getStageName (Stage stage);
+
+private:
+
+	std::array<Histogram, numStages> stages;
+};
+
+}  // namespace Imogen
@@ -11,21 +11,53 @@ State::State() : plugin::CustomState<Parameters, CustomStateData> ("Imogen")
 	meters.addToList (getParameters());
 }
 
+bool State::isUsingOfflineProfile() const noexcept
+{
+	switch (qualityProfile.load())
+	{
+		case (QualityProfile::realtime) : return false;
+		case (QualityProfile::offline) : return true;
+		default : return nonRealtime.load();
+	}
+}
+
+int State::getPrepareSettings() const noexcept
+{
+	const auto& quality = isUsingOfflineProfile() ? internals.offlineQuality : internals.realtimeQuality;
+
+	auto flag = [] (bool isOn, int bit)
+	{ return isOn ? 1 << bit : 0; };
+
+	return parameters.analysisProfile->get()
+		 | quality->get() << 3
+		 | flag (internals.fixedInternalRate->get(), 5)
+		 | flag (internals.pipelinedAnalysis->get(), 6)
+		 | flag (internals.parallelPostHarmony->get(), 7)
+		 | flag (internals.flightRecorderEnabled->get(), 8);
+}
+
 Parameters::Parameters()
 	: ParameterList ("ImogenParameters")
 {
 	add (inputMode, dryWet, inputGain, outputGain, leadBypass, harmonyBypass, stereoWidth, lowestPanned, leadPan, noiseGateToggle, noiseGateThresh, deEsserToggle, deEsserThresh, deEsserAmount, compToggle, compAmount, delayToggle, delayDryWet, limiterToggle);
+
+	// new parameters go after the existing ones, so hosts' parameter indices don't change
+	addInternal (analysisProfile);
+	autoHarmonyState.addToList (*this);
+	unisonState.addToList (*this);
+	add (formantPreservation);
 }
 
 
 void Meters::addToList (plugin::ParameterList& list)
 {
 	list.add (inputLevel, outputLevelL, outputLevelR, gateRedux, compRedux, deEssRedux, limRedux, reverbLevel, delayLevel);
+	list.addInternal (cpuLoad, cpuLoadPeak, blockOverruns, qualityTier, inputVoicing);
 }
 
 void Internals::addToList (plugin::ParameterList& list)
 {
-	list.addInternal (abletonLinkEnabled, abletonLinkSessionPeers, mtsEspIsConnected, lastMovedMidiController, lastMovedCCValue, guiDarkMode, currentInputNote, currentCentsSharp);
+	list.addInternal (abletonLinkEnabled, abletonLinkSessionPeers, mtsEspIsConnected, lastMovedMidiController, lastMovedCCValue, guiDarkMode, parallelPostHarmony, pipelinedAnalysis, fixedInternalRate, flightRecorderEnabled, qualityGovernor, unvoicedFastPath, midiOutput, realtimeQuality, offlineQuality, currentInputNote, currentCentsSharp, forcedQualityTier);
 	// mtsEspScaleName
 }
 
@@ -42,6 +74,18 @@ ReverbState::ReverbState (plugin::ParameterList& list)
 }
 
 
+void AutoHarmonyState::addToList (plugin::ParameterList& list)
+{
+	list.add (autoHarmonyToggle, autoHarmonyKey, autoHarmonyScale, autoHarmonyVoicing);
+}
+
+
+void UnisonState::addToList (plugin::ParameterList& list)
+{
+	list.add (unisonVoices, unisonDetune);
+}
+
+
 MidiState::MidiState (plugin::ParameterList& list)
 {
 	list.add (pitchbendRange, velocitySens, aftertouchToggle, voiceStealing, midiLatch, pitchGlide, glideTime, adsrAttack, adsrDecay, adsrSustain, adsrRelease, pedalToggle, pedalThresh, descantToggle, descantThresh, descantInterval);
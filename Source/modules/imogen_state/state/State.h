@@ -3,6 +3,10 @@
 #include "Parameters.h"
 #include "Meters.h"
 #include "Internals.h"
+#include "StageTimings.h"
+#include "TraceRecorder.h"
+#include "FlightRecorder.h"
+#include "TuningTable.h"
 
 
 namespace Imogen
@@ -15,12 +19,41 @@ private:
 };
 
 
+/* Which of the quality profiles in the Internals the engine uses. */
+enum class QualityProfile
+{
+	followHost,	 // the offline profile while the host renders offline, otherwise the realtime one
+	realtime,
+	offline
+};
+
+
 struct State : plugin::CustomState<Parameters, CustomStateData>
 {
 	State();
 
 	Internals internals;
 	Meters	  meters;
+
+	StageTimings   stageTimings;
+	TraceRecorder  trace;
+	FlightRecorder flightRecorder;
+	TuningTable	   tuning;
+
+	/* Set by the processor while the host is rendering offline. */
+	std::atomic<bool> nonRealtime { false };
+
+	std::atomic<QualityProfile> qualityProfile { QualityProfile::followHost };
+
+	/* True if the engine should use the offline profile, which also keeps the CPU quality governor out of the way. */
+	bool isUsingOfflineProfile() const noexcept;
+
+	/* Packs together every setting the engine only reads when it's prepared. */
+	int getPrepareSettings() const noexcept;
+
+	/* The prepare settings the engine was last prepared with, or -1 before it's first prepared.
+	   When they no longer match the current ones, the processor prepares the engine again. */
+	std::atomic<int> preparedSettings { -1 };
 };
 
 }  // namespace Imogen
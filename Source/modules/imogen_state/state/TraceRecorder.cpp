@@ -0,0 +1,159 @@
+
+namespace Imogen
+{
+void TraceRecorder::enable (int capacity)
+{
+	disable();
+
+	const auto size = juce::nextPowerOfTwo (juce::jmax (1024, capacity));
+
+	events.resize (static_cast<size_t> (size));
+	mask = static_cast<juce::uint64> (size - 1);
+
+	clear();
+
+	enabled.store (true);
+}
+
+void TraceRecorder::disable() noexcept
+{
+	enabled.store (false);
+}
+
+bool TraceRecorder::isEnabled() const noexcept
+{
+	return enabled.load (std::memory_order_relaxed);
+}
+
+void TraceRecorder::clear() noexcept
+{
+	writeIndex.store (0);
+	origin = std::chrono::steady_clock::now();
+}
+
+juce::int64 TraceRecorder::getNanosSinceOrigin() const noexcept
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now() - origin).count();
+}
+
+void TraceRecorder::record (EventType type, Category category, int id, int value) noexcept
+{
+	if (! isEnabled())
+		return;
+
+	const auto index = writeIndex.fetch_add (1, std::memory_order_relaxed);
+
+	auto& event = events[static_cast<size_t> (index & mask)];
+
+	event.timestampNanos = getNanosSinceOrigin();
+	event.threadID		 = juce::Thread::getCurrentThreadId();
+	event.id			 = id;
+	event.value			 = value;
+	event.type			 = type;
+	event.category		 = category;
+}
+
+juce::String TraceRecorder::getWorkerName (Worker worker)
+{
+	switch (worker)
+	{
+		case (Worker::analysisPipeline) : return "Analysis pipeline";
+		case (Worker::dryBranch) : return "Dry branch";
+	}
+
+	return {};
+}
+
+void TraceRecorder::writeChromeTrace (juce::OutputStream& stream, const juce::StringArray& parameterNames) const
+{
+	const auto numWritten = writeIndex.load();
+	const auto numEvents  = juce::jmin (numWritten, static_cast<juce::uint64> (events.size()));
+
+	// Chrome wants small integer thread IDs
+	juce::Array<juce::Thread::ThreadID> threads;
+
+	const auto getEventName = [&] (const Event& event) -> juce::String
+	{
+		switch (event.category)
+		{
+			case (Category::stage) : return StageTimings::getStageName (static_cast<StageTimings::Stage> (event.id));
+			case (Category::voice) : return "Voice " + juce::String (event.id);
+			case (Category::parameter) : return parameterNames[event.id];
+			case (Category::worker) : return getWorkerName (static_cast<Worker> (event.id));
+		}
+
+		return {};
+	};
+
+	// voices overlap each other and the stages, so they're written as async events, which don't have to nest
+	const auto getPhase = [] (const Event& event) -> const char*
+	{
+		switch (event.type)
+		{
+			case (EventType::begin) : return event.category == Category::voice ? "b" : "B";
+			case (EventType::end) : return event.category == Category::voice ? "e" : "E";
+			case (EventType::instant) : return "i";
+		}
+
+		return "";
+	};
+
+	const auto getCategoryName = [] (Category category) -> const char*
+	{
+		switch (category)
+		{
+			case (Category::stage) : return "stage";
+			case (Category::voice) : return "voice";
+			case (Category::parameter) : return "parameter";
+			case (Category::worker) : return "worker";
+		}
+
+		return "";
+	};
+
+	stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+	for (auto i = numWritten - numEvents; i < numWritten; ++i)
+	{
+		const auto& event = events[static_cast<size_t> (i & mask)];
+
+		if (! threads.contains (event.threadID))
+			threads.add (event.threadID);
+
+		if (i > numWritten - numEvents)
+			stream << ',';
+
+		stream << juce::newLine
+			   << "{\"name\":" << juce::JSON::toString (getEventName (event))
+			   << ",\"cat\":\"" << getCategoryName (event.category) << '"'
+			   << ",\"ph\":\"" << getPhase (event) << '"'
+			   << ",\"ts\":" << juce::String (static_cast<double> (event.timestampNanos) / 1000., 3)
+			   << ",\"pid\":1,\"tid\":" << threads.indexOf (event.threadID) + 1;
+
+		if (event.type == EventType::instant)
+			stream << ",\"s\":\"t\"";
+
+		if (event.category == Category::voice)
+			stream << ",\"id\":" << event.id << ",\"args\":{\"note\":" << event.value << '}';
+		else if (event.category == Category::parameter)
+			stream << ",\"args\":{\"value\":" << juce::String (static_cast<double> (event.value) / 1000., 3) << '}';
+
+		stream << '}';
+	}
+
+	stream << juce::newLine << "]}" << juce::newLine;
+}
+
+
+ScopedTraceEvent::ScopedTraceEvent (TraceRecorder& recorderToUse, TraceRecorder::Category categoryToUse, int idToUse) noexcept
+	: recorder (recorderToUse), category (categoryToUse), id (idToUse)
+{
+	recorder.record (TraceRecorder::EventType::begin, category, id);
+}
+
+ScopedTraceEvent::~ScopedTraceEvent()
+{
+	recorder.record (TraceRecorder::EventType::end, category, id);
+}
+
+}  // namespace Imogen
@@ -0,0 +1,94 @@
+#pragma once
+
+namespace Imogen
+{
+/* Records timestamped trace events into a preallocated ring buffer, and writes them out as Chrome trace JSON
+   (which Perfetto and chrome://tracing can both open).
+   Recording is lock-free and never allocates; it does nothing until enable() has been called.
+   Each event claims its own slot with an atomic increment, so the engine's worker threads can record alongside the audio thread.
+*/
+struct TraceRecorder
+{
+	enum class EventType : juce::uint8
+	{
+		begin,
+		end,
+		instant
+	};
+
+	enum class Category : juce::uint8
+	{
+		stage,		// id is a StageTimings::Stage
+		voice,		// id is the voice index, value is the MIDI note
+		parameter,	// id is the parameter index, value is the new normalised value in thousandths
+		worker		// id is a Worker
+	};
+
+	enum class Worker
+	{
+		analysisPipeline,
+		dryBranch
+	};
+
+	struct Event
+	{
+		juce::int64			   timestampNanos;
+		juce::Thread::ThreadID threadID;
+		int					   id;
+		int					   value;
+		EventType			   type;
+		Category			   category;
+	};
+
+	/* Allocates room for the given number of events (rounded up to a power of 2), then starts recording. Not realtime safe. */
+	void enable (int capacity = 1 << 18);
+
+	void disable() noexcept;
+
+	bool isEnabled() const noexcept;
+
+	void record (EventType type, Category category, int id, int value = 0) noexcept;
+
+	/* Discards everything recorded so far, and restarts the timeline at 0. */
+	void clear() noexcept;
+
+	/* Writes the most recent events, oldest first. Only call this while nothing is recording.
+	   The parameter names are used to label parameter events; they should be in parameter index order.
+	*/
+	void writeChromeTrace (juce::OutputStream& stream, const juce::StringArray& parameterNames) const;
+
+	static juce::String getWorkerName (Worker worker);
+
+private:
+
+	juce::int64 getNanosSinceOrigin() const noexcept;
+
+	std::vector<Event> events;
+
+	juce::uint64 mask { 0 };
+
+	std::atomic<juce::uint64> writeIndex { 0 };
+
+	std::atomic<bool> enabled { false };
+
+	std::chrono::steady_clock::time_point origin { std::chrono::steady_clock::now() };
+};
+
+
+/* Records a begin event when it's created and the matching end event when it's destroyed. */
+struct ScopedTraceEvent
+{
+	ScopedTraceEvent (TraceRecorder& recorderToUse, TraceRecorder::Category categoryToUse, int idToUse) noexcept;
+
+	~ScopedTraceEvent();
+
+private:
+
+	TraceRecorder&			recorder;
+	TraceRecorder::Category category;
+	int						id;
+
+	JUCE_DECLARE_NON_COPYABLE (ScopedTraceEvent)
+};
+
+}  // namespace Imogen
@@ -0,0 +1,231 @@
+
+namespace Imogen
+{
+namespace
+{
+/* The lines of a Scala file that aren't comments, with any trailing text after the first value removed. */
+juce::StringArray getScalaValues (const juce::String& text, bool keepFirstLineWhole)
+{
+	juce::StringArray values;
+
+	for (const auto& line : juce::StringArray::fromLines (text))
+	{
+		if (line.startsWithChar ('!'))
+			continue;
+
+		if (keepFirstLineWhole && values.isEmpty())
+		{
+			values.add (line.trim());
+			continue;
+		}
+
+		const auto value = line.trim().upToFirstOccurrenceOf (" ", false, false).upToFirstOccurrenceOf ("\t", false, false);
+
+		if (value.isNotEmpty())
+			values.add (value);
+	}
+
+	return values;
+}
+
+bool parseScalaPitch (const juce::String& value, double& cents)
+{
+	if (value.containsChar ('.'))
+	{
+		cents = value.getDoubleValue();
+		return true;
+	}
+
+	const auto numerator   = value.upToFirstOccurrenceOf ("/", false, false).getDoubleValue();
+	const auto denominator = value.containsChar ('/') ? value.fromFirstOccurrenceOf ("/", false, false).getDoubleValue() : 1.;
+
+	if (numerator <= 0. || denominator <= 0.)
+		return false;
+
+	cents = 1200. * std::log2 (numerator / denominator);
+	return true;
+}
+}  // namespace
+
+bool ScalaScale::parse (const juce::String& text, ScalaScale& result)
+{
+	const auto values = getScalaValues (text, true);
+
+	if (values.size() < 2)
+		return false;
+
+	const auto numDegrees = values[1].getIntValue();
+
+	if (numDegrees <= 0 || values.size() < numDegrees + 2)
+		return false;
+
+	result.description = values[0];
+	result.degreeCents.clearQuick();
+
+	for (int i = 0; i < numDegrees; ++i)
+	{
+		double cents;
+
+		if (! parseScalaPitch (values[i + 2], cents))
+			return false;
+
+		result.degreeCents.add (cents);
+	}
+
+	return true;
+}
+
+bool KeyboardMapping::parse (const juce::String& text, KeyboardMapping& result)
+{
+	const auto values = getScalaValues (text, false);
+
+	if (values.size() < 7)
+		return false;
+
+	const auto mapSize = values[0].getIntValue();
+
+	if (mapSize < 0)
+		return false;
+
+	result.firstNote		  = values[1].getIntValue();
+	result.lastNote			  = values[2].getIntValue();
+	result.middleNote		  = values[3].getIntValue();
+	result.referenceNote	  = values[4].getIntValue();
+	result.referenceFrequency = values[5].getDoubleValue();
+	result.octaveDegree		  = values[6].getIntValue();
+
+	if (result.referenceFrequency <= 0.)
+		return false;
+
+	result.keys.clearQuick();
+
+	// a mapping may leave off its last keys, which are then unmapped
+	for (int i = 0; i < mapSize; ++i)
+	{
+		const auto& value = values[i + 7];
+		result.keys.add (value.isEmpty() || value.equalsIgnoreCase ("x") ? -1 : value.getIntValue());
+	}
+
+	return true;
+}
+
+
+TuningTable::TuningTable()
+{
+	reset();
+}
+
+void TuningTable::reset()
+{
+	const auto inactive = 1 - activeTable.load();
+
+	tables[static_cast<size_t> (inactive)].fill (1.);
+
+	activeTable.store (inactive);
+	scaleLoaded.store (false);
+
+	scaleName = TRANS ("12-TET");
+}
+
+bool TuningTable::loadFiles (const juce::File& scaleFile, const juce::File& mappingFile)
+{
+	ScalaScale scale;
+
+	if (! ScalaScale::parse (scaleFile.loadFileAsString(), scale))
+		return false;
+
+	KeyboardMapping mapping;
+
+	if (mappingFile != juce::File() && ! KeyboardMapping::parse (mappingFile.loadFileAsString(), mapping))
+		return false;
+
+	load (scale, mapping);
+
+	if (scale.description.isEmpty())
+		scaleName = scaleFile.getFileNameWithoutExtension();
+
+	return true;
+}
+
+double TuningTable::getDegreeCents (const ScalaScale& scale, int degree)
+{
+	const auto numDegrees = scale.degreeCents.size();
+	const auto period	  = scale.degreeCents.getLast();
+
+	const auto periods = (degree >= 0 ? degree : degree - (numDegrees - 1)) / numDegrees;
+	const auto step	   = degree - periods * numDegrees;
+
+	return periods * period + (step == 0 ? 0. : scale.degreeCents.getUnchecked (step - 1));
+}
+
+void TuningTable::load (const ScalaScale& scale, const KeyboardMapping& mapping)
+{
+	jassert (! scale.degreeCents.isEmpty());
+
+	const auto mapSize = mapping.keys.size();
+
+	const auto octaveCents = mapping.octaveDegree > 0 ? getDegreeCents (scale, mapping.octaveDegree) : scale.degreeCents.getLast();
+
+	// returns false for keys the mapping leaves unmapped
+	const auto getNoteCents = [&] (int note, double& cents)
+	{
+		if (note < mapping.firstNote || note > mapping.lastNote)
+			return false;
+
+		const auto fromMiddle = note - mapping.middleNote;
+
+		if (mapSize == 0)
+		{
+			cents = getDegreeCents (scale, fromMiddle);
+			return true;
+		}
+
+		const auto repeats = (fromMiddle >= 0 ? fromMiddle : fromMiddle - (mapSize - 1)) / mapSize;
+		const auto degree  = mapping.keys.getUnchecked (fromMiddle - repeats * mapSize);
+
+		if (degree < 0)
+			return false;
+
+		cents = getDegreeCents (scale, degree) + repeats * octaveCents;
+		return true;
+	};
+
+	auto referenceCents = 0.;
+
+	if (! getNoteCents (mapping.referenceNote, referenceCents))
+		referenceCents = getDegreeCents (scale, 0);
+
+	const auto inactive = 1 - activeTable.load();
+	auto&	   table	= tables[static_cast<size_t> (inactive)];
+
+	for (int note = 0; note < numNotes; ++note)
+	{
+		auto cents = 0.;
+
+		if (! getNoteCents (note, cents))
+		{
+			table[static_cast<size_t> (note)] = 1.;
+			continue;
+		}
+
+		const auto frequency	  = mapping.referenceFrequency * std::pow (2., (cents - referenceCents) / 1200.);
+		const auto equalTempered = 440. * std::pow (2., (note - 69) / 12.);
+
+		table[static_cast<size_t> (note)] = frequency / equalTempered;
+	}
+
+	activeTable.store (inactive);
+	scaleLoaded.store (true);
+
+	scaleName = scale.description;
+}
+
+double TuningTable::getFrequencyRatio (int midiNote) const noexcept
+{
+	if (! juce::isPositiveAndBelow (midiNote, numNotes))
+		return 1.;
+
+	return tables[static_cast<size_t> (activeTable.load())][static_cast<size_t> (midiNote)];
+}
+
+}  // namespace Imogen
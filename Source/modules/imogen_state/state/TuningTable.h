@@ -0,0 +1,80 @@
+#pragma once
+
+namespace Imogen
+{
+/* A Scala .scl scale. Each degree is in cents above the first note of the scale (which is implicitly 0 cents);
+   the last degree is the scale's period, usually an octave.
+*/
+struct ScalaScale
+{
+	juce::String	   description;
+	juce::Array<double> degreeCents;
+
+	static bool parse (const juce::String& text, ScalaScale& result);
+};
+
+
+/* A Scala .kbm keyboard mapping, saying which scale degree each key plays and which key is tuned to the reference frequency.
+   An empty mapping maps each key to the next scale degree, starting from the middle note.
+*/
+struct KeyboardMapping
+{
+	int firstNote { 0 }, lastNote { 127 };
+	int middleNote { 60 };
+	int referenceNote { 69 };
+
+	double referenceFrequency { 440. };
+
+	// which scale degree each repetition of the mapping transposes by; 0 means the scale's period
+	int octaveDegree { 0 };
+
+	// -1 for unmapped keys
+	juce::Array<int> keys;
+
+	static bool parse (const juce::String& text, KeyboardMapping& result);
+};
+
+
+/* Holds, for each MIDI note, how far a loaded scale retunes it away from 12-tone equal temperament.
+   Scales are loaded on the message thread, and the audio thread only ever reads a finished table, so retuning
+   costs the voices one lookup per block. Only one load should happen at a time.
+*/
+class TuningTable
+{
+public:
+
+	static constexpr int numNotes = 128;
+
+	TuningTable();
+
+	/* The mapping file is optional. Returns false if either file couldn't be read, leaving the current tuning in place. */
+	bool loadFiles (const juce::File& scaleFile, const juce::File& mappingFile = {});
+
+	void load (const ScalaScale& scale, const KeyboardMapping& mapping = {});
+
+	/* Goes back to 12-tone equal temperament. */
+	void reset();
+
+	/* The frequency of the note under the loaded scale, divided by its equal-tempered frequency. */
+	double getFrequencyRatio (int midiNote) const noexcept;
+
+	bool hasScale() const noexcept { return scaleLoaded.load(); }
+
+	/* Message thread only. */
+	juce::String getScaleName() const { return scaleName; }
+
+private:
+
+	using Ratios = std::array<double, numNotes>;
+
+	static double getDegreeCents (const ScalaScale& scale, int degree);
+
+	std::array<Ratios, 2> tables;
+
+	std::atomic<int>  activeTable { 0 };
+	std::atomic<bool> scaleLoaded { false };
+
+	juce::String scaleName;
+};
+
+}  // namespace Imogen
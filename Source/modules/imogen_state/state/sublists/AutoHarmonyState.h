@@ -0,0 +1,45 @@
+#pragma once
+
+namespace Imogen
+{
+/* Settings for generating harmonies from the lead's pitch, without any MIDI input. */
+struct AutoHarmonyState
+{
+	void addToList (plugin::ParameterList& list);
+
+	ToggleParam autoHarmonyToggle { "Auto harmony", false };
+
+	IntParam autoHarmonyKey { 0, 11, 0, "Auto harmony key",
+							  [] (int value, int maxLength)
+							  { return juce::MidiMessage::getMidiNoteName (value, true, false, 4).substring (0, maxLength); } };
+
+	IntParam autoHarmonyScale { 0, 5, 0, "Auto harmony scale",
+								[] (int value, int maxLength)
+								{
+									switch (value)
+									{
+										case (1) : return TRANS ("Natural minor").substring (0, maxLength);
+										case (2) : return TRANS ("Harmonic minor").substring (0, maxLength);
+										case (3) : return TRANS ("Melodic minor").substring (0, maxLength);
+										case (4) : return TRANS ("Dorian").substring (0, maxLength);
+										case (5) : return TRANS ("Mixolydian").substring (0, maxLength);
+										default : return TRANS ("Major").substring (0, maxLength);
+									}
+								} };
+
+	IntParam autoHarmonyVoicing { 0, 5, 1, "Auto harmony voicing",
+								  [] (int value, int maxLength)
+								  {
+									  switch (value)
+									  {
+										  case (1) : return TRANS ("3rd & 5th above").substring (0, maxLength);
+										  case (2) : return TRANS ("6th below").substring (0, maxLength);
+										  case (3) : return TRANS ("3rd above & 6th below").substring (0, maxLength);
+										  case (4) : return TRANS ("Triad below").substring (0, maxLength);
+										  case (5) : return TRANS ("Four-part below").substring (0, maxLength);
+										  default : return TRANS ("3rd above").substring (0, maxLength);
+									  }
+								  } };
+};
+
+}  // namespace Imogen
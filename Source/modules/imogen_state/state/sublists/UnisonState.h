@@ -0,0 +1,15 @@
+#pragma once
+
+namespace Imogen
+{
+/* Settings for thickening each harmony note into a small section, from a single render of it. */
+struct UnisonState
+{
+	void addToList (plugin::ParameterList& list);
+
+	IntParam unisonVoices { 1, 8, 1, "Unison voices" };
+
+	PercentParam unisonDetune { "Unison detune", 30 };
+};
+
+}  // namespace Imogen
@@ -0,0 +1,98 @@
+
+#include <imogen_render/imogen_render.h>
+
+int main (int argc, char* argv[])
+{
+	using namespace Imogen;
+
+	juce::ScopedJuceInitialiser_GUI juceInit;
+
+	juce::ConsoleApplication app;
+
+	app.addHelpCommand ("--help|-h", "Usage:", true);
+
+	app.addDefaultCommand ({ "render",
+							 "[--preset <file>] [--scl <file> [--kbm <file>]] [--double] [--trace] [--threads <n>] [--blocksize <n>] <audio.wav> <midi.mid> <output.wav> [...]",
+							 "Renders each (audio, MIDI, output) triple through Imogen, faster than real time",
+							 "Each job gets its own Imogen engine; jobs are spread across the given number of threads (default: one per CPU). "
+							 "--trace also writes a Chrome trace of each job next to its output, which can be opened in Perfetto.",
+							 [] (const juce::ArgumentList& arguments)
+							 {
+								 auto args = arguments;
+
+								 RenderSettings settings;
+
+								 settings.preset		  = juce::File::getCurrentWorkingDirectory().getChildFile (args.removeValueForOption ("--preset"));
+								 settings.doublePrecision = args.removeOptionIfFound ("--double");
+								 settings.writeTrace	  = args.removeOptionIfFound ("--trace");
+
+								 if (const auto scale = args.removeValueForOption ("--scl"); scale.isNotEmpty())
+									 settings.scale = juce::File::getCurrentWorkingDirectory().getChildFile (scale);
+
+								 if (const auto mapping = args.removeValueForOption ("--kbm"); mapping.isNotEmpty())
+									 settings.keyboardMapping = juce::File::getCurrentWorkingDirectory().getChildFile (mapping);
+
+								 if (const auto blocksize = args.removeValueForOption ("--blocksize"); blocksize.isNotEmpty())
+									 settings.blocksize = juce::jmax (1, blocksize.getIntValue());
+
+								 const auto numThreads = args.removeValueForOption ("--threads").getIntValue();
+
+								 if (args.size() == 0 || args.size() % 3 != 0)
+									 juce::ConsoleApplication::fail ("Expected one or more <audio.wav> <midi.mid> <output.wav> triples");
+
+								 std::vector<RenderJob> jobs;
+
+								 for (int i = 0; i < args.size(); i += 3)
+									 jobs.push_back ({ args[i].resolveAsExistingFile(), args[i + 1].resolveAsFile(), args[i + 2].resolveAsFile() });
+
+								 const auto results = renderInParallel (jobs, settings, numThreads);
+
+								 auto failures = 0;
+
+								 for (int i = 0; i < results.size(); ++i)
+								 {
+									 if (results[i].isEmpty())
+									 {
+										 std::cout << "Rendered " << jobs[static_cast<size_t> (i)].output.getFullPathName() << std::endl;
+									 }
+									 else
+									 {
+										 std::cerr << results[i] << std::endl;
+										 ++failures;
+									 }
+								 }
+
+								 if (failures > 0)
+									 juce::ConsoleApplication::fail (juce::String (failures) + " of " + juce::String (results.size()) + " jobs failed");
+							 } });
+
+	app.addCommand ({ "--replay",
+					  "--replay [--double] <capture folder> <output.wav>",
+					  "Replays a flight recorder capture offline",
+					  "Restores the captured processor state, then renders the captured input with its MIDI and parameter changes.",
+					  [] (const juce::ArgumentList& arguments)
+					  {
+						  auto args = arguments;
+
+						  args.removeOptionIfFound ("--replay");
+
+						  RenderSettings settings;
+
+						  settings.doublePrecision = args.removeOptionIfFound ("--double");
+
+						  if (args.size() != 2)
+							  juce::ConsoleApplication::fail ("Expected <capture folder> <output.wav>");
+
+						  OfflineRenderer renderer { settings };
+
+						  const auto output = args[1].resolveAsFile();
+						  const auto error	= renderer.replay (args[0].resolveAsExistingFolder(), output);
+
+						  if (error.isNotEmpty())
+							  juce::ConsoleApplication::fail (error);
+
+						  std::cout << "Rendered " << output.getFullPathName() << std::endl;
+					  } });
+
+	return app.findAndRunCommand (argc, argv);
+}
@@ -0,0 +1,49 @@
+#include <imogen_render/imogen_render.h>
+
+int main (int argc, char* argv[])
+{
+	using namespace Imogen;
+
+	juce::ScopedJuceInitialiser_GUI juceInit;
+
+	juce::ConsoleApplication app;
+
+	app.addHelpCommand ("--help|-h", "Usage:", true);
+
+	app.addDefaultCommand ({ "rtcheck",
+							 "[--double] [--abort]",
+							 "Checks that Imogen's audio thread never allocates, locks or sleeps",
+							 "Drives every MIDI path and every parameter through the engine, in each of its processing modes. "
+							 "Every allocation, lock or sleep on the audio thread is reported to stderr with its stack. "
+							 "--abort stops at the first one, so it can be caught in a debugger.",
+							 [] (const juce::ArgumentList& arguments)
+							 {
+								 auto args = arguments;
+
+								 const auto useDouble = args.removeOptionIfFound ("--double");
+
+								 RealtimeChecker::setAbortOnViolation (args.removeOptionIfFound ("--abort"));
+
+								 RealtimeSafetyCheck check { useDouble };
+
+								 const auto results = check.run();
+
+								 auto failures = 0;
+
+								 for (const auto& result : results)
+								 {
+									 if (result.numViolations == 0)
+										 continue;
+
+									 std::cout << result.scenario << ": " << result.numViolations << " violations" << std::endl;
+									 ++failures;
+								 }
+
+								 if (failures > 0)
+									 juce::ConsoleApplication::fail (juce::String (failures) + " of " + juce::String (results.size()) + " scenarios were not realtime safe");
+
+								 std::cout << "All " << results.size() << " scenarios were realtime safe" << std::endl;
+							 } });
+
+	return app.findAndRunCommand (argc, argv);
+}